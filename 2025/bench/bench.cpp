@@ -0,0 +1,498 @@
+/* Benchmarks for the parse and solve stages of each day
+
+Usage: aoc_bench [--seed=N] [benchmark options]
+
+The inputs are synthetic (see generators.h), generated from the seed (default 2025)
+at the size given by each benchmark's argument: rotations, ranges, banks, grid side
+or IDs. Parse benchmarks time readPuzzleInput on the generated file, solve benchmarks
+the solvers on the parsed input. items_per_second is the throughput in records (cells
+for day 4), bytes_per_second in bytes of input.
+
+Unless --benchmark_out is given, the results are also written as JSON to aoc_bench.json.
+*/
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <random>
+#include <span>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "day1.h"
+#include "day2.h"
+#include "day3.h"
+#include "day4.h"
+#include "day5.h"
+#include "generators.h"
+
+namespace {
+
+uint64_t seed = 2025;
+
+struct Input {
+    std::string path;
+    std::size_t bytes = 0;
+};
+
+// Generated input files, written on first use and removed at exit
+class InputCache {
+public:
+    ~InputCache() {
+        for (auto& entry : inputs) std::remove(entry.second.path.c_str());
+    }
+
+    template <typename Generate>
+    const Input& get(const std::string& name, Generate&& generate) {
+        auto found = inputs.find(name);
+        if (found != inputs.end()) return found->second;
+        std::string text = generate();
+        Input input;
+        input.path = (std::filesystem::temp_directory_path() /
+             ("aoc_bench_" + std::to_string(getpid()) + "_" + name + ".txt")).string();
+        input.bytes = text.size();
+        generators::writeFile(input.path, text);
+        return inputs.emplace(name, input).first->second;
+    }
+
+private:
+    std::map<std::string, Input> inputs;
+};
+
+InputCache cache;
+
+std::string key(const char* day, std::size_t size) {
+    return std::string(day) + "_" + std::to_string(size);
+}
+
+const Input& rotations(std::size_t size) {
+    return cache.get(key("day1", size), [&] { return generators::rotationLog(size, seed); });
+}
+
+const Input& ranges(std::size_t size) {
+    return cache.get(key("day2", size), [&] { return generators::rangeList(size, seed); });
+}
+
+const Input& banks(std::size_t size) {
+    return cache.get(key("day3", size), [&] { return generators::digitBanks(size, 100, seed); });
+}
+
+const Input& grid(std::size_t side) {
+    return cache.get(key("day4", side), [&] { return generators::rollGrid(side, side, 0.6, seed); });
+}
+
+// Day 5 databases have one range for every four IDs
+const Input& database(std::size_t ids) {
+    return cache.get(key("day5", ids), [&] { return generators::freshDatabase(ids / 4, ids, seed); });
+}
+
+void setThroughput(benchmark::State& state, std::size_t records, std::size_t bytes) {
+    state.SetItemsProcessed(state.iterations() * records);
+    state.SetBytesProcessed(state.iterations() * bytes);
+}
+
+// Day 1
+
+void BM_Day1Parse(benchmark::State& state) {
+    const Input& input = rotations(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(day1::readPuzzleInput(input.path));
+    }
+    setThroughput(state, state.range(0), input.bytes);
+}
+
+void BM_Day1Landings(benchmark::State& state) {
+    const Input& input = rotations(state.range(0));
+    auto parsed = day1::readPuzzleInput(input.path);
+    for (auto _ : state) {
+        unsigned int position = 50;
+        unsigned long int zeros = 0;
+        for (std::size_t i = 0; i < parsed.first.size(); i++) {
+            position = day1::rotateLock(position, parsed.first[i], parsed.second[i]);
+            zeros = zeros + (position == 0);
+        }
+        benchmark::DoNotOptimize(zeros);
+    }
+    setThroughput(state, state.range(0), input.bytes);
+}
+
+void BM_Day1Crossings(benchmark::State& state) {
+    const Input& input = rotations(state.range(0));
+    auto parsed = day1::readPuzzleInput(input.path);
+    for (auto _ : state) {
+        unsigned int position = 50;
+        unsigned long int zeros = 0;
+        for (std::size_t i = 0; i < parsed.first.size(); i++) {
+            zeros = zeros + day1::countZeroCrossings(position, parsed.first[i], parsed.second[i]);
+            position = day1::rotateLock(position, parsed.first[i], parsed.second[i]);
+        }
+        benchmark::DoNotOptimize(zeros);
+    }
+    setThroughput(state, state.range(0), input.bytes);
+}
+
+void BM_Day1Transfer(benchmark::State& state) {
+    const Input& input = rotations(state.range(0));
+    auto parsed = day1::readPuzzleInput(input.path);
+    for (auto _ : state) {
+        auto transfer = day1::buildTransfer(parsed.first.data(), parsed.second.data(), parsed.first.size());
+        benchmark::DoNotOptimize(transfer.zeros[50]);
+    }
+    setThroughput(state, state.range(0), input.bytes);
+}
+
+BENCHMARK(BM_Day1Parse)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(BM_Day1Landings)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(BM_Day1Crossings)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+BENCHMARK(BM_Day1Transfer)->RangeMultiplier(16)->Range(1 << 12, 1 << 20);
+
+// Day 2
+
+void BM_Day2Parse(benchmark::State& state) {
+    const Input& input = ranges(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(day2::readPuzzleInput(input.path));
+    }
+    setThroughput(state, state.range(0), input.bytes);
+}
+
+void BM_Day2Twice(benchmark::State& state) {
+    const Input& input = ranges(state.range(0));
+    auto parsed = day2::readPuzzleInput(input.path);
+    for (auto _ : state) {
+        unsigned long int result = 0;
+        for (auto r : parsed) result = result + day2::sumInvalidIDs(r.first, r.second);
+        benchmark::DoNotOptimize(result);
+    }
+    setThroughput(state, state.range(0), input.bytes);
+}
+
+void BM_Day2Repeated(benchmark::State& state) {
+    const Input& input = ranges(state.range(0));
+    auto parsed = day2::readPuzzleInput(input.path);
+    for (auto _ : state) {
+        unsigned long int result = 0;
+        for (auto r : parsed) result = result + day2::sumRepeatedPatternIDs(r.first, r.second);
+        benchmark::DoNotOptimize(result);
+    }
+    setThroughput(state, state.range(0), input.bytes);
+}
+
+// The brute-force scan visits every ID, so it runs on fewer ranges
+void BM_Day2Scan(benchmark::State& state) {
+    const Input& input = ranges(state.range(0));
+    auto parsed = day2::readPuzzleInput(input.path);
+    for (auto _ : state) {
+        unsigned long int result = 0;
+        for (auto r : parsed) result = result + day2::sumInvalidIDsByScan(r.first, r.second);
+        benchmark::DoNotOptimize(result);
+    }
+    setThroughput(state, state.range(0), input.bytes);
+}
+
+BENCHMARK(BM_Day2Parse)->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+BENCHMARK(BM_Day2Twice)->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+BENCHMARK(BM_Day2Repeated)->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+BENCHMARK(BM_Day2Scan)->Arg(1 << 4)->Arg(1 << 6)->Unit(benchmark::kMillisecond);
+
+// Day 3
+
+void BM_Day3Parse(benchmark::State& state) {
+    const Input& input = banks(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(day3::readPuzzleInput(input.path));
+    }
+    setThroughput(state, state.range(0), input.bytes);
+}
+
+void BM_Day3TwoDigits(benchmark::State& state) {
+    const Input& input = banks(state.range(0));
+    auto parsed = day3::readPuzzleInput(input.path);
+    for (auto _ : state) {
+        unsigned long int result = 0;
+        for (const auto& bank : parsed) result = result + day3::getLargestJoltageInBank(bank);
+        benchmark::DoNotOptimize(result);
+    }
+    setThroughput(state, state.range(0), input.bytes);
+}
+
+void BM_Day3TwelveDigits(benchmark::State& state) {
+    const Input& input = banks(state.range(0));
+    auto parsed = day3::readPuzzleInput(input.path);
+    std::vector<std::vector<uint8_t>> digits;
+    for (const auto& bank : parsed) digits.emplace_back(bank.begin(), bank.end());
+    for (auto _ : state) {
+        unsigned long int result = 0;
+        for (const auto& bank : digits) result = result + day3::getLargestJoltage(std::span<const uint8_t>(bank), 12);
+        benchmark::DoNotOptimize(result);
+    }
+    setThroughput(state, state.range(0), input.bytes);
+}
+
+void BM_Day3ParseBuffer(benchmark::State& state) {
+    const Input& input = banks(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(day3::readBankBuffer(input.path));
+    }
+    setThroughput(state, state.range(0), input.bytes);
+}
+
+void BM_Day3Buffer(benchmark::State& state) {
+    const Input& input = banks(state.range(0));
+    auto parsed = day3::readBankBuffer(input.path);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(day3::sumLargestJoltage(parsed, state.range(1)));
+    }
+    setThroughput(state, state.range(0), input.bytes);
+}
+
+BENCHMARK(BM_Day3Parse)->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+BENCHMARK(BM_Day3TwoDigits)->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+BENCHMARK(BM_Day3TwelveDigits)->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+BENCHMARK(BM_Day3ParseBuffer)->RangeMultiplier(16)->Range(1 << 8, 1 << 16);
+BENCHMARK(BM_Day3Buffer)->ArgsProduct({{1 << 8, 1 << 12, 1 << 16}, {2, 12}})->UseRealTime();
+
+// Day 4
+
+void BM_Day4Parse(benchmark::State& state) {
+    const Input& input = grid(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(day4::readPuzzleInput(input.path));
+    }
+    setThroughput(state, state.range(0) * state.range(0), input.bytes);
+}
+
+void BM_Day4ParsePacked(benchmark::State& state) {
+    const Input& input = grid(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(day4::readPackedPuzzleInput(input.path));
+    }
+    setThroughput(state, state.range(0) * state.range(0), input.bytes);
+}
+
+void BM_Day4Rows(benchmark::State& state) {
+    const Input& input = grid(state.range(0));
+    auto parsed = day4::readPuzzleInput(input.path);
+    for (auto _ : state) {
+        unsigned long int result = 0;
+        for (std::size_t i = 1; i + 1 < parsed.size(); i++) {
+            result = result + day4::countAccessibleRolls(parsed[i - 1], parsed[i], parsed[i + 1]);
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    setThroughput(state, state.range(0) * state.range(0), input.bytes);
+}
+
+void BM_Day4Bytes(benchmark::State& state) {
+    const Input& input = grid(state.range(0));
+    auto parsed = day4::toByteGrid(day4::readPuzzleInput(input.path));
+    for (auto _ : state) {
+        unsigned long int result = 0;
+        for (std::size_t i = 1; i + 1 < parsed.size(); i++) {
+            result = result + day4::countAccessibleRolls(parsed[i - 1], parsed[i], parsed[i + 1]);
+        }
+        benchmark::DoNotOptimize(result);
+    }
+    setThroughput(state, state.range(0) * state.range(0), input.bytes);
+}
+
+void BM_Day4Packed(benchmark::State& state) {
+    const Input& input = grid(state.range(0));
+    auto parsed = day4::readPackedPuzzleInput(input.path);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(day4::countAccessibleRollsPacked(parsed));
+    }
+    setThroughput(state, state.range(0) * state.range(0), input.bytes);
+}
+
+void BM_Day4Removal(benchmark::State& state) {
+    const Input& input = grid(state.range(0));
+    auto parsed = day4::readPuzzleInput(input.path);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(day4::removeAccessibleRolls(parsed));
+    }
+    setThroughput(state, state.range(0) * state.range(0), input.bytes);
+}
+
+// Batches of 4096 random edits applied to a FloorMap of the grid, inverted after
+// every batch so that the edits keep changing the grid
+void BM_Day4Edits(benchmark::State& state) {
+    const Input& input = grid(state.range(0));
+    day4::FloorMap floor(day4::readPuzzleInput(input.path));
+    std::mt19937_64 rng(seed);
+    std::vector<day4::FloorMap::Edit> edits(4096);
+    for (auto& edit : edits) edit = {rng() % floor.rows(), rng() % floor.cols(), (rng() % 2) == 0};
+    for (auto _ : state) {
+        floor.apply(edits);
+        benchmark::DoNotOptimize(floor.accessible());
+        for (auto& edit : edits) edit.roll = !edit.roll;
+    }
+    state.SetItemsProcessed(state.iterations() * edits.size());
+}
+
+// Tiled sweep of a 4096 x 4096 grid from 1 to N threads (powers of two, and N)
+void threadScaling(benchmark::internal::Benchmark* benchmark) {
+    unsigned int threads = defaultThreadCount();
+    for (unsigned int t = 1; t < threads; t *= 2) benchmark->Args({4096, t});
+    benchmark->Args({4096, threads});
+}
+
+void BM_Day4TiledPacked(benchmark::State& state) {
+    const Input& input = grid(state.range(0));
+    auto parsed = day4::readPackedPuzzleInput(input.path);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(day4::countAccessibleRollsTiled(parsed, day4::SweepGeometry(), state.range(1)));
+    }
+    setThroughput(state, state.range(0) * state.range(0), input.bytes);
+}
+
+void BM_Day4TiledBytes(benchmark::State& state) {
+    const Input& input = grid(state.range(0));
+    auto parsed = day4::toByteGrid(day4::readPuzzleInput(input.path));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(day4::countAccessibleRollsTiled(parsed, day4::SweepGeometry(), state.range(1)));
+    }
+    setThroughput(state, state.range(0) * state.range(0), input.bytes);
+}
+
+// Tile geometry (band rows, tile columns) of the byte layout on all threads
+void BM_Day4TileGeometry(benchmark::State& state) {
+    const Input& input = grid(4096);
+    auto parsed = day4::toByteGrid(day4::readPuzzleInput(input.path));
+    day4::SweepGeometry geometry{static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(1))};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(day4::countAccessibleRollsTiled(parsed, geometry));
+    }
+    setThroughput(state, 4096 * 4096, input.bytes);
+}
+
+BENCHMARK(BM_Day4Parse)->RangeMultiplier(4)->Range(128, 2048);
+BENCHMARK(BM_Day4ParsePacked)->RangeMultiplier(4)->Range(128, 2048);
+BENCHMARK(BM_Day4Rows)->RangeMultiplier(4)->Range(128, 2048);
+BENCHMARK(BM_Day4Bytes)->RangeMultiplier(4)->Range(128, 2048);
+BENCHMARK(BM_Day4Packed)->RangeMultiplier(4)->Range(128, 2048);
+BENCHMARK(BM_Day4TiledPacked)->Apply(threadScaling)->UseRealTime();
+BENCHMARK(BM_Day4TiledBytes)->Apply(threadScaling)->UseRealTime();
+BENCHMARK(BM_Day4TileGeometry)->ArgsProduct({{4, 64, 1024}, {1024, 16384}})->UseRealTime();
+BENCHMARK(BM_Day4Edits)->RangeMultiplier(4)->Range(128, 2048);
+BENCHMARK(BM_Day4Removal)->RangeMultiplier(4)->Range(128, 2048)->Unit(benchmark::kMillisecond);
+
+// Day 5
+
+void BM_Day5Parse(benchmark::State& state) {
+    const Input& input = database(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(day5::readPuzzleInput(input.path));
+    }
+    setThroughput(state, state.range(0) + state.range(0) / 4, input.bytes);
+}
+
+// The nested loop is O(IDs x ranges), so it runs on small databases only
+void BM_Day5NestedLoop(benchmark::State& state) {
+    const Input& input = database(state.range(0));
+    auto parsed = day5::readPuzzleInput(input.path);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(day5::countFreshProducts(parsed.first, parsed.second));
+    }
+    setThroughput(state, state.range(0), input.bytes);
+}
+
+void BM_Day5Indexed(benchmark::State& state) {
+    const Input& input = database(state.range(0));
+    auto parsed = day5::readPuzzleInput(input.path);
+    for (auto _ : state) {
+        auto merged = day5::mergeRanges(parsed.first);
+        benchmark::DoNotOptimize(day5::countFreshProductsIndexed(merged, parsed.second));
+    }
+    setThroughput(state, state.range(0), input.bytes);
+}
+
+void BM_Day5Eytzinger(benchmark::State& state) {
+    const Input& input = database(state.range(0));
+    auto parsed = day5::readPuzzleInput(input.path);
+    for (auto _ : state) {
+        day5::FreshIndex index(day5::mergeRanges(parsed.first));
+        benchmark::DoNotOptimize(index.count(parsed.second));
+    }
+    setThroughput(state, state.range(0), input.bytes);
+}
+
+void BM_Day5Coverage(benchmark::State& state) {
+    const Input& input = database(state.range(0));
+    auto parsed = day5::readPuzzleInput(input.path);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(day5::countFreshIDs(parsed.first));
+    }
+    setThroughput(state, state.range(0) / 4, input.bytes);
+}
+
+// The lookups alone, with the ranges merged and indexed up front. The second argument
+// picks the engine: binary search, sorted sweep, Eytzinger scalar or Eytzinger batch.
+void BM_Day5Lookups(benchmark::State& state) {
+    const Input& input = database(state.range(0));
+    auto parsed = day5::readPuzzleInput(input.path);
+    auto merged = day5::mergeRanges(parsed.first);
+    day5::FreshIndex index(merged);
+    const auto& IDs = parsed.second;
+    static const char* engines[] = {"binary search", "sorted sweep", "eytzinger scalar", "eytzinger batch"};
+    state.SetLabel(engines[state.range(1)]);
+    std::vector<uint64_t> bits((IDs.size() + 63) / 64);
+    for (auto _ : state) {
+        switch (state.range(1)) {
+        case 0:
+            benchmark::DoNotOptimize(day5::countFreshProductsIndexed(merged, IDs));
+            break;
+        case 1:
+            benchmark::DoNotOptimize(day5::countFreshProductsSorted(merged, IDs));
+            break;
+        case 2:
+            std::fill(bits.begin(), bits.end(), 0);
+            index.queryScalar(IDs.data(), IDs.size(), bits.data());
+            benchmark::DoNotOptimize(bits.data());
+            break;
+        default:
+            benchmark::DoNotOptimize(index.count(IDs));
+        }
+    }
+    setThroughput(state, state.range(0), input.bytes);
+}
+
+BENCHMARK(BM_Day5Parse)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_Day5NestedLoop)->RangeMultiplier(4)->Range(1 << 8, 1 << 12);
+BENCHMARK(BM_Day5Indexed)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_Day5Eytzinger)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_Day5Coverage)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+BENCHMARK(BM_Day5Lookups)->ArgsProduct({{1 << 10, 1 << 14, 1 << 18}, {0, 1, 2, 3}});
+
+}
+
+int main(int argc, char** argv) {
+    // Take out --seed, and ask for JSON output unless an output file was given
+    std::vector<char*> args;
+    bool output = false;
+    for (int i = 0; i < argc; i++) {
+        if (std::strncmp(argv[i], "--seed=", 7) == 0) {
+            seed = std::stoull(argv[i] + 7);
+            continue;
+        }
+        if (std::strncmp(argv[i], "--benchmark_out=", 16) == 0) output = true;
+        args.push_back(argv[i]);
+    }
+    std::string out = "--benchmark_out=aoc_bench.json";
+    std::string format = "--benchmark_out_format=json";
+    if (!output) {
+        args.push_back(out.data());
+        args.push_back(format.data());
+    }
+    int count = static_cast<int>(args.size());
+    benchmark::Initialize(&count, args.data());
+    if (benchmark::ReportUnrecognizedArguments(count, args.data())) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
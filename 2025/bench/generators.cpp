@@ -0,0 +1,111 @@
+/* Synthetic puzzle inputs for benchmarks and tests */
+
+#include "generators.h"
+
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+
+namespace generators {
+
+std::string rotationLog(std::size_t rotations, uint64_t seed, unsigned int maxPositions) {
+    std::mt19937_64 rng(seed);
+    std::string text;
+    text.reserve(rotations * 5);
+    for (std::size_t i = 0; i < rotations; i++) {
+        text += (rng() & 1) ? 'R' : 'L';
+        text += std::to_string(1 + rng() % maxPositions);
+        text += '\n';
+    }
+    return text;
+}
+
+std::string rangeList(std::size_t ranges, uint64_t seed, unsigned int maxDigits, unsigned long int maxWidth) {
+    // 10^19 is the largest power of ten below 2^64
+    if (maxDigits == 0 || maxDigits > 19 || maxWidth == 0) {
+        throw std::invalid_argument("Cannot generate ranges of up to " + std::to_string(maxDigits) +
+             " digits and " + std::to_string(maxWidth) + " IDs");
+    }
+    std::mt19937_64 rng(seed);
+    unsigned long int limit = 1;
+    for (unsigned int i = 0; i < maxDigits; i++) limit = limit * 10;
+    std::string text;
+    text.reserve(ranges * (2 * maxDigits + 2));
+    for (std::size_t i = 0; i < ranges; i++) {
+        // Pick the length of the first ID uniformly, so that short IDs are as common as long ones
+        unsigned long int low = 1;
+        unsigned int digits = 1 + rng() % maxDigits;
+        for (unsigned int d = 1; d < digits; d++) low = low * 10;
+        unsigned long int first = low + rng() % (std::min(low * 10, limit) - low);
+        unsigned long int last = first + 1 + rng() % maxWidth;
+        if (i > 0) text += ',';
+        text += std::to_string(first);
+        text += '-';
+        text += std::to_string(last);
+    }
+    text += '\n';
+    return text;
+}
+
+std::string digitBanks(std::size_t banks, std::size_t length, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::string text;
+    text.reserve(banks * (length + 1));
+    for (std::size_t i = 0; i < banks; i++) {
+        for (std::size_t j = 0; j < length; j++) {
+            text += static_cast<char>('1' + rng() % 9);
+        }
+        text += '\n';
+    }
+    return text;
+}
+
+std::string rollGrid(std::size_t rows, std::size_t cols, double density, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::bernoulli_distribution roll(density);
+    std::string text;
+    text.reserve(rows * (cols + 1));
+    for (std::size_t i = 0; i < rows; i++) {
+        for (std::size_t j = 0; j < cols; j++) {
+            text += roll(rng) ? '@' : '.';
+        }
+        text += '\n';
+    }
+    return text;
+}
+
+std::string freshDatabase(std::size_t ranges, std::size_t ids, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    const unsigned long int space = 1000000000000000UL;
+    // Ranges are about as wide as the gaps between them, so roughly half the IDs are fresh
+    const unsigned long int width = space / (ranges + 1);
+    std::string text;
+    text.reserve(ranges * 32 + ids * 16 + 1);
+    for (std::size_t i = 0; i < ranges; i++) {
+        unsigned long int first = rng() % space;
+        text += std::to_string(first);
+        text += '-';
+        text += std::to_string(first + rng() % width);
+        text += '\n';
+    }
+    text += '\n';
+    for (std::size_t i = 0; i < ids; i++) {
+        text += std::to_string(rng() % space);
+        text += '\n';
+    }
+    return text;
+}
+
+void writeFile(const std::string& filename, const std::string& text) {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Failed to open file: " + filename);
+    }
+    file.write(text.data(), text.size());
+    if (!file) {
+        throw std::runtime_error("Failed to write file: " + filename);
+    }
+}
+
+} // namespace generators
@@ -0,0 +1,37 @@
+/* Synthetic puzzle inputs for benchmarks and tests
+
+Each generator produces the text of an input file in the format of one day, with
+the given number of records. The same seed always produces the same input.
+*/
+
+#ifndef AOC_2025_GENERATORS_H
+#define AOC_2025_GENERATORS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace generators {
+
+// Day 1: one rotation per line, "L68" or "R48", with magnitudes 1 to maxPositions
+std::string rotationLog(std::size_t rotations, uint64_t seed, unsigned int maxPositions = 999);
+
+// Day 2: a single line of comma separated ranges "first-last", with first below
+// 10^maxDigits and each range at most maxWidth IDs wide. maxDigits is 1 to 19.
+std::string rangeList(std::size_t ranges, uint64_t seed, unsigned int maxDigits = 10,
+     unsigned long int maxWidth = 1000000);
+
+// Day 3: one bank of length digits 1-9 per line
+std::string digitBanks(std::size_t banks, std::size_t length, uint64_t seed);
+
+// Day 4: rows x cols grid of '@' (a roll, with probability density) and '.'
+std::string rollGrid(std::size_t rows, std::size_t cols, double density, uint64_t seed);
+
+// Day 5: ranges "first-last" below 10^15, a blank line, then the IDs to check
+std::string freshDatabase(std::size_t ranges, std::size_t ids, uint64_t seed);
+
+void writeFile(const std::string& filename, const std::string& text);
+
+} // namespace generators
+
+#endif
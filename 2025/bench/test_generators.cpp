@@ -0,0 +1,81 @@
+/* Tests for the input generators, checking that each day parses what they produce */
+
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "day1.h"
+#include "day2.h"
+#include "day3.h"
+#include "day4.h"
+#include "day5.h"
+#include "generators.h"
+#include "../common/check.h"
+
+using namespace generators;
+
+int main() {
+
+    std::string path = (std::filesystem::temp_directory_path() / "aoc_test_generators.txt").string();
+
+    // Check the same seed gives the same input, and another seed a different one
+    CHECK(rotationLog(100, 1) == rotationLog(100, 1));
+    CHECK(rotationLog(100, 1) != rotationLog(100, 2));
+    CHECK(freshDatabase(10, 100, 7) == freshDatabase(10, 100, 7));
+    std::cout << "All tests for generator seeds pass" << std::endl;
+
+    writeFile(path, rotationLog(1000, 1, 99));
+    auto rotations = day1::readPuzzleInput(path);
+    CHECK(rotations.first.size() == 1000 && rotations.second.size() == 1000);
+    for (auto positions : rotations.second) CHECK(positions >= 1 && positions <= 99);
+    std::cout << "All tests for rotationLog pass" << std::endl;
+
+    writeFile(path, rangeList(500, 2, 6, 1000));
+    auto ranges = day2::readPuzzleInput(path);
+    CHECK(ranges.size() == 500);
+    for (auto r : ranges) {
+        CHECK(r.first >= 1 && r.first < 1000000 && r.second > r.first && r.second - r.first <= 1000);
+    }
+    writeFile(path, rangeList(500, 2, 19, 1000));
+    for (auto r : day2::readPuzzleInput(path)) {
+        CHECK(r.first >= 1 && r.first < 10000000000000000000UL && r.second > r.first && r.second - r.first <= 1000);
+    }
+    bool rejected = false;
+    try {
+        rangeList(10, 2, 20);
+    }
+    catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    CHECK(rejected);
+    std::cout << "All tests for rangeList pass" << std::endl;
+
+    writeFile(path, digitBanks(50, 100, 3));
+    auto banks = day3::readPuzzleInput(path);
+    CHECK(banks.size() == 50);
+    for (const auto& bank : banks) {
+        CHECK(bank.size() == 100);
+        for (auto digit : bank) CHECK(digit >= 1 && digit <= 9);
+    }
+    std::cout << "All tests for digitBanks pass" << std::endl;
+
+    writeFile(path, rollGrid(30, 70, 0.5, 4));
+    auto grid = day4::readPuzzleInput(path);
+    CHECK(grid.size() == 32 && grid[0].size() == 72);
+    auto packed = day4::readPackedPuzzleInput(path);
+    CHECK(packed.rows == 30 && packed.cols == 70);
+    writeFile(path, rollGrid(10, 10, 0.0, 4));
+    CHECK(day4::solvePuzzle(path) == 0);
+    std::cout << "All tests for rollGrid pass" << std::endl;
+
+    writeFile(path, freshDatabase(20, 300, 5));
+    auto database = day5::readPuzzleInput(path);
+    CHECK(database.first.size() == 20 && database.second.size() == 300);
+    for (auto r : database.first) CHECK(r.first <= r.second);
+    std::cout << "All tests for freshDatabase pass" << std::endl;
+
+    std::remove(path.c_str());
+    return 0;
+}
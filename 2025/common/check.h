@@ -0,0 +1,30 @@
+/* Test checks for the 2025 solutions
+
+CHECK works like assert, but is not compiled out when NDEBUG is defined, so the
+tests keep checking in Release builds. scratchFile names a file for a test to write
+in the temporary directory, so the tests leave the source tree alone.
+*/
+
+#ifndef AOC_COMMON_CHECK_H
+#define AOC_COMMON_CHECK_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+#include <unistd.h>
+
+[[noreturn]] inline void checkFailed(const char* condition, const char* file, int line) {
+    std::fprintf(stderr, "%s:%d: Check failed: %s\n", file, line, condition);
+    std::abort();
+}
+
+#define CHECK(condition) ((condition) ? (void)0 : checkFailed(#condition, __FILE__, __LINE__))
+
+// The process ID keeps tests running at the same time apart
+inline std::string scratchFile(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("aoc_" + std::to_string(::getpid()) + "_" + name)).string();
+}
+
+#endif
@@ -0,0 +1,113 @@
+/* Line decoders for the 2025 solutions
+
+decodeDigits turns a run of ASCII digits into one byte per digit (0 to 9), and
+decodeRolls turns a row of '@' and '.' into one bit per cell, set for '@', bit
+c % 64 of word c / 64 for column c. Both validate every byte as they go and return
+the offset of the first byte that is not valid, or the size of the input when all
+of it is. The AVX2 versions decode 32 bytes per step and are selected at runtime
+when the CPU supports them.
+*/
+
+#ifndef AOC_COMMON_DECODE_H
+#define AOC_COMMON_DECODE_H
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+using DigitDecoder = std::size_t (*)(const char* text, std::size_t size, uint8_t* digits);
+using RollDecoder = std::size_t (*)(const char* text, std::size_t size, uint64_t* bits);
+
+inline std::size_t decodeDigitsScalar(const char* text, std::size_t size, uint8_t* digits) {
+    for (std::size_t i = 0; i < size; i++) {
+        uint8_t digit = static_cast<uint8_t>(text[i] - '0');
+        if (digit > 9) return i;
+        digits[i] = digit;
+    }
+    return size;
+}
+
+// Stops before writing the word that holds the first invalid byte
+inline std::size_t decodeRollsScalar(const char* text, std::size_t size, uint64_t* bits) {
+    for (std::size_t start = 0; start < size; start += 64) {
+        std::size_t end = (size - start < 64) ? size : start + 64;
+        uint64_t word = 0;
+        for (std::size_t i = start; i < end; i++) {
+            if (text[i] == '@') word |= uint64_t(1) << (i - start);
+            else if (text[i] != '.') return i;
+        }
+        bits[start / 64] = word;
+    }
+    return size;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("avx2")))
+inline std::size_t decodeDigitsAVX2(const char* text, std::size_t size, uint8_t* digits) {
+    const __m256i zero = _mm256_set1_epi8('0');
+    const __m256i nine = _mm256_set1_epi8(9);
+    std::size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i));
+        // Bytes below '0' wrap around, so every byte that is not a digit ends up above 9
+        __m256i values = _mm256_sub_epi8(chars, zero);
+        __m256i valid = _mm256_cmpeq_epi8(_mm256_min_epu8(values, nine), values);
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(valid));
+        if (mask != 0xFFFFFFFFu) return i + __builtin_ctz(~mask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(digits + i), values);
+    }
+    return i + decodeDigitsScalar(text + i, size - i, digits + i);
+}
+
+__attribute__((target("avx2")))
+inline std::size_t decodeRollsAVX2(const char* text, std::size_t size, uint64_t* bits) {
+    const __m256i roll = _mm256_set1_epi8('@');
+    const __m256i empty = _mm256_set1_epi8('.');
+    std::size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        uint64_t word = 0;
+        for (std::size_t half = 0; half < 64; half += 32) {
+            __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + i + half));
+            __m256i rolls = _mm256_cmpeq_epi8(chars, roll);
+            __m256i valid = _mm256_or_si256(rolls, _mm256_cmpeq_epi8(chars, empty));
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(valid));
+            if (mask != 0xFFFFFFFFu) return i + half + __builtin_ctz(~mask);
+            word |= uint64_t(static_cast<uint32_t>(_mm256_movemask_epi8(rolls))) << half;
+        }
+        bits[i / 64] = word;
+    }
+    return i + decodeRollsScalar(text + i, size - i, bits + i / 64);
+}
+#endif
+
+inline DigitDecoder selectDigitDecoder() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return decodeDigitsAVX2;
+#endif
+    return decodeDigitsScalar;
+}
+
+inline RollDecoder selectRollDecoder() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return decodeRollsAVX2;
+#endif
+    return decodeRollsScalar;
+}
+
+inline std::size_t decodeDigits(const char* text, std::size_t size, uint8_t* digits) {
+    static const DigitDecoder decoder = selectDigitDecoder();
+    return decoder(text, size, digits);
+}
+
+// bits must hold (size + 63) / 64 words
+inline std::size_t decodeRolls(const char* text, std::size_t size, uint64_t* bits) {
+    static const RollDecoder decoder = selectRollDecoder();
+    return decoder(text, size, bits);
+}
+
+#endif
@@ -0,0 +1,210 @@
+/* Shared input layer for the 2025 solutions
+
+Files are memory mapped and handed out line by line as std::string_view, so
+reading the input does not copy or allocate per line. Standard input (filename
+"-") and other files that cannot be mapped are streamed through a fixed buffer
+instead. Numbers are parsed straight from the views with std::from_chars.
+*/
+
+#ifndef AOC_COMMON_INPUT_H
+#define AOC_COMMON_INPUT_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+class LineReader {
+public:
+    static constexpr std::size_t bufferSize = 1 << 16;
+
+    explicit LineReader(const std::string& filename) : filename_(filename) {
+        if (filename == "-") {
+            fd_ = STDIN_FILENO;
+            ownsFd_ = false;
+        }
+        else {
+            fd_ = ::open(filename.c_str(), O_RDONLY);
+            if (fd_ < 0) {
+                throw std::runtime_error("Failed to open file: " + filename);
+            }
+        }
+
+        struct stat info;
+        if (::fstat(fd_, &info) == 0 && S_ISREG(info.st_mode)) {
+            size_ = info.st_size;
+            if (size_ == 0) {
+                mapped_ = true;
+                return;
+            }
+            void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+            if (data != MAP_FAILED) {
+                ::madvise(data, size_, MADV_SEQUENTIAL);
+                data_ = static_cast<const char*>(data);
+                mapped_ = true;
+                return;
+            }
+        }
+        // Not a regular file or mmap failed: stream it
+        buffer_.resize(bufferSize);
+        size_ = 0;
+    }
+
+    LineReader(const LineReader&) = delete;
+    LineReader& operator=(const LineReader&) = delete;
+
+    ~LineReader() {
+        if (data_) ::munmap(const_cast<char*>(data_), size_);
+        if (ownsFd_ && fd_ >= 0) ::close(fd_);
+    }
+
+    const std::string& filename() const { return filename_; }
+
+    // Whole contents of a mapped file, empty when the input is streamed
+    std::string_view contents() const {
+        return mapped_ ? std::string_view(data_, size_) : std::string_view();
+    }
+
+    // Next line without its line terminator. The view stays valid until the next
+    // call for streamed input, and for the lifetime of the reader for mapped files.
+    bool next(std::string_view& line) {
+        if (mapped_) {
+            if (pos_ >= size_) return false;
+            const char* begin = data_ + pos_;
+            const char* newline = static_cast<const char*>(std::memchr(begin, '\n', size_ - pos_));
+            std::size_t length = newline ? newline - begin : size_ - pos_;
+            pos_ = pos_ + length + 1;
+            terminated_ = newline != nullptr;
+            line = trimCarriageReturn(std::string_view(begin, length));
+            return true;
+        }
+        return nextStreamed(line);
+    }
+
+    // Whether the line last returned by next() ended in '\n'. Only the last line of
+    // the input can be unterminated, e.g. while the input is still being written.
+    bool terminated() const { return terminated_; }
+
+    // Byte offset in the input of the line the next call to next() returns
+    std::size_t offset() const {
+        return mapped_ ? std::min(pos_, size_) : start_ + pos_;
+    }
+
+    // Continue reading at a byte offset, e.g. one taken from offset() in an earlier
+    // run. Returns false, leaving the reader unchanged, when the input cannot seek
+    // (a pipe or terminal) or is shorter than offset.
+    bool seek(std::size_t offset) {
+        if (mapped_) {
+            if (offset > size_) return false;
+            pos_ = offset;
+            return true;
+        }
+        struct stat info;
+        if (::fstat(fd_, &info) != 0 || !S_ISREG(info.st_mode) || offset > static_cast<std::size_t>(info.st_size) ||
+             ::lseek(fd_, offset, SEEK_SET) < 0) {
+            return false;
+        }
+        start_ = offset;
+        size_ = 0;
+        pos_ = 0;
+        eof_ = false;
+        return true;
+    }
+
+private:
+    static std::string_view trimCarriageReturn(std::string_view line) {
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        return line;
+    }
+
+    bool nextStreamed(std::string_view& line) {
+        while (true) {
+            const char* begin = buffer_.data() + pos_;
+            const char* newline = static_cast<const char*>(std::memchr(begin, '\n', size_ - pos_));
+            if (newline) {
+                line = trimCarriageReturn(std::string_view(begin, newline - begin));
+                pos_ = newline - buffer_.data() + 1;
+                terminated_ = true;
+                return true;
+            }
+            if (eof_) {
+                if (pos_ == size_) return false;
+                line = trimCarriageReturn(std::string_view(begin, size_ - pos_));
+                pos_ = size_;
+                terminated_ = false;
+                return true;
+            }
+            // Keep the partial line at the front of the buffer and refill the rest.
+            // The buffer only grows for lines longer than itself.
+            std::memmove(buffer_.data(), begin, size_ - pos_);
+            start_ = start_ + pos_;
+            size_ = size_ - pos_;
+            pos_ = 0;
+            if (size_ == buffer_.size()) buffer_.resize(2 * buffer_.size());
+            ssize_t count = ::read(fd_, buffer_.data() + size_, buffer_.size() - size_);
+            if (count < 0) {
+                throw std::runtime_error("Failed to read file: " + filename_);
+            }
+            if (count == 0) eof_ = true;
+            size_ = size_ + count;
+        }
+    }
+
+    std::string filename_;
+    int fd_ = -1;
+    bool ownsFd_ = true;
+    bool mapped_ = false;
+    bool eof_ = false;
+    bool terminated_ = false;
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t pos_ = 0;
+    std::size_t start_ = 0; // Offset of buffer_[0] in a streamed input
+    std::vector<char> buffer_;
+};
+
+// Splits a line into the fields between a delimiter
+class FieldSplitter {
+public:
+    FieldSplitter(std::string_view text, char delimiter) : text_(text), delimiter_(delimiter) {}
+
+    bool next(std::string_view& field) {
+        if (done_) return false;
+        auto pos = text_.find(delimiter_);
+        if (pos == std::string_view::npos) {
+            field = text_;
+            done_ = true;
+        }
+        else {
+            field = text_.substr(0, pos);
+            text_.remove_prefix(pos + 1);
+        }
+        return true;
+    }
+
+private:
+    std::string_view text_;
+    char delimiter_;
+    bool done_ = false;
+};
+
+template <typename T>
+T parseNumber(std::string_view text) {
+    T value{};
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc() || end != text.data() + text.size() || text.empty()) {
+        throw std::runtime_error("Invalid number: " + std::string(text));
+    }
+    return value;
+}
+
+#endif
@@ -0,0 +1,128 @@
+/* Minimal parallel loop for the 2025 solutions
+
+parallelFor runs body(index) for every index in [0, count) on up to `threads`
+threads (the calling thread included). Indices are handed out one at a time
+from a shared counter, so uneven work items balance across the threads.
+parallelSum does the same and adds up what body returns for every index.
+
+ThreadPool keeps a fixed set of threads for tasks that are not known up front:
+a running task can submit more tasks, and wait() returns once all are done.
+*/
+
+#ifndef AOC_COMMON_PARALLEL_H
+#define AOC_COMMON_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+inline unsigned int defaultThreadCount() {
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+// body is called as body(index, worker), where worker in [0, threads) identifies
+// the calling thread, e.g. to accumulate into per-thread results
+template <typename Body>
+void parallelFor(std::size_t count, unsigned int threads, Body&& body) {
+    std::size_t workers = std::min<std::size_t>(std::max(1u, threads), count);
+    std::atomic<std::size_t> next{0};
+    auto work = [&](unsigned int worker) {
+        for (std::size_t i = next++; i < count; i = next++) {
+            body(i, worker);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned int worker = 1; worker < workers; worker++) {
+        pool.emplace_back(work, worker);
+    }
+    if (count > 0) work(0);
+    for (auto& thread : pool) thread.join();
+}
+
+// Sum of body(index) over [0, count), run as parallelFor. Each thread adds into its
+// own slot, a cache line apart, so the threads do not share the line they write to.
+template <typename T = unsigned long int, typename Body>
+T parallelSum(std::size_t count, unsigned int threads, Body&& body) {
+    struct alignas(64) PartialSum {
+        T value = 0;
+    };
+    std::vector<PartialSum> sums(std::max(1u, threads));
+    parallelFor(count, threads, [&](std::size_t i, unsigned int worker) {
+        sums[worker].value = sums[worker].value + body(i);
+    });
+
+    T result = 0;
+    for (auto& sum : sums) result = result + sum.value;
+    return result;
+}
+
+class ThreadPool {
+public:
+    explicit ThreadPool(unsigned int threads = defaultThreadCount()) {
+        for (unsigned int i = 0; i < std::max(1u, threads); i++) {
+            workers.emplace_back([this] { work(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        ready.notify_all();
+        for (auto& thread : workers) thread.join();
+    }
+
+    // Tasks must not throw; catch inside the task to report errors
+    void submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.push_back(std::move(task));
+            pending++;
+        }
+        ready.notify_one();
+    }
+
+    // Wait until every submitted task, including the ones submitted by tasks, has finished
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        idle.wait(lock, [this] { return pending == 0; });
+    }
+
+    std::size_t size() const { return workers.size(); }
+
+private:
+    void work() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            ready.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) return;
+            auto task = std::move(tasks.front());
+            tasks.pop_front();
+            lock.unlock();
+            task();
+            lock.lock();
+            if (--pending == 0) idle.notify_all();
+        }
+    }
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::size_t pending = 0;
+    bool stopping = false;
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::condition_variable idle;
+};
+
+#endif
@@ -0,0 +1,251 @@
+/* Instrumentation for the 2025 solutions
+
+AOC_PROFILE_SCOPE(name) times the rest of the enclosing scope, and
+AOC_PROFILE_COUNT(name, n) adds n to a counter. Both compile to nothing unless
+AOC_PROFILE is defined (cmake -DAOC_PROFILE=ON), so the solvers can be left
+instrumented at no cost.
+
+In a profiling build every thread records into its own table of call sites,
+which is merged into the process totals when the thread exits. At exit a flat
+profile (calls, self and total time, counters, by name) is written to stderr,
+and when AOC_TRACE names a file, a Chrome trace of the timed scopes (for
+chrome://tracing or Perfetto) is written to it. Time is measured with rdtsc
+where available, calibrated against steady_clock, and steady_clock otherwise.
+*/
+
+#ifndef AOC_COMMON_PROFILE_H
+#define AOC_COMMON_PROFILE_H
+
+#define AOC_PROFILE_CONCAT_(a, b) a##b
+#define AOC_PROFILE_CONCAT(a, b) AOC_PROFILE_CONCAT_(a, b)
+
+#ifndef AOC_PROFILE
+
+#define AOC_PROFILE_SCOPE(name) ((void)0)
+#define AOC_PROFILE_COUNT(name, n) ((void)0)
+
+#else
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace profile {
+
+inline uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+         std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+struct Stats {
+    uint64_t calls = 0;
+    uint64_t ticks = 0;
+    uint64_t childTicks = 0;
+    uint64_t count = 0;
+};
+
+struct Event {
+    std::size_t site;
+    uint64_t begin;
+    uint64_t end;
+};
+
+// Process totals, merged from the threads as they exit and reported at exit
+class Profiler {
+public:
+    static constexpr std::size_t maxEventsPerThread = 1 << 20;
+
+    static Profiler& instance() {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    std::size_t registerSite(const char* name) {
+        std::lock_guard<std::mutex> lock(mutex);
+        names.push_back(name);
+        return names.size() - 1;
+    }
+
+    bool tracing() const { return !tracePath.empty(); }
+
+    void merge(const std::vector<Stats>& stats, std::vector<Event>& events, uint64_t dropped) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (totals.size() < stats.size()) totals.resize(stats.size());
+        for (std::size_t i = 0; i < stats.size(); i++) {
+            totals[i].calls += stats[i].calls;
+            totals[i].ticks += stats[i].ticks;
+            totals[i].childTicks += stats[i].childTicks;
+            totals[i].count += stats[i].count;
+        }
+        if (tracing() && !events.empty()) traces.emplace_back(std::move(events));
+        droppedEvents += dropped;
+    }
+
+    ~Profiler() {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto clockEnd = std::chrono::steady_clock::now();
+        uint64_t tickEnd = now();
+        std::chrono::duration<double, std::nano> elapsed = clockEnd - clockStart;
+        double nsPerTick = (tickEnd > tickStart) ? elapsed.count() / double(tickEnd - tickStart) : 1.0;
+        writeProfile(nsPerTick);
+        if (tracing()) writeTrace(nsPerTick);
+    }
+
+private:
+    Profiler() : clockStart(std::chrono::steady_clock::now()), tickStart(now()) {
+        if (const char* path = std::getenv("AOC_TRACE")) tracePath = path;
+    }
+
+    // Sites with the same name (e.g. overloads) are reported together
+    void writeProfile(double nsPerTick) {
+        std::map<std::string, Stats> byName;
+        for (std::size_t i = 0; i < totals.size(); i++) {
+            Stats& stats = byName[names[i]];
+            stats.calls += totals[i].calls;
+            stats.ticks += totals[i].ticks;
+            stats.childTicks += totals[i].childTicks;
+            stats.count += totals[i].count;
+        }
+        std::vector<std::pair<std::string, Stats>> rows(byName.begin(), byName.end());
+        std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+            return a.second.ticks - a.second.childTicks > b.second.ticks - b.second.childTicks;
+        });
+        std::fprintf(stderr, "%12s %12s %12s %12s %14s  %s\n", "self ms", "total ms", "calls", "ns/call", "count", "name");
+        for (const auto& [name, stats] : rows) {
+            double total = stats.ticks * nsPerTick;
+            double self = (stats.ticks - stats.childTicks) * nsPerTick;
+            double perCall = stats.calls ? total / stats.calls : 0;
+            std::fprintf(stderr, "%12.3f %12.3f %12lu %12.1f %14lu  %s\n", self / 1e6, total / 1e6,
+                 (unsigned long)stats.calls, perCall, (unsigned long)stats.count, name.c_str());
+        }
+        if (droppedEvents > 0) {
+            std::fprintf(stderr, "%lu trace events dropped\n", (unsigned long)droppedEvents);
+        }
+    }
+
+    void writeTrace(double nsPerTick) {
+        std::FILE* file = std::fopen(tracePath.c_str(), "w");
+        if (!file) {
+            std::fprintf(stderr, "Failed to open file: %s\n", tracePath.c_str());
+            return;
+        }
+        std::fprintf(file, "{\"traceEvents\":[");
+        bool first = true;
+        for (std::size_t thread = 0; thread < traces.size(); thread++) {
+            for (const auto& event : traces[thread]) {
+                double begin = (event.begin - tickStart) * nsPerTick / 1e3;
+                double duration = (event.end - event.begin) * nsPerTick / 1e3;
+                std::fprintf(file, "%s\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%zu,\"ts\":%.3f,\"dur\":%.3f}",
+                     first ? "" : ",", names[event.site], thread + 1, begin, duration);
+                first = false;
+            }
+        }
+        std::fprintf(file, "\n]}\n");
+        std::fclose(file);
+    }
+
+    std::mutex mutex;
+    std::chrono::steady_clock::time_point clockStart;
+    uint64_t tickStart;
+    std::string tracePath;
+    std::vector<const char*> names;
+    std::vector<Stats> totals;
+    std::vector<std::vector<Event>> traces;
+    uint64_t droppedEvents = 0;
+};
+
+class ScopedTimer;
+
+// Per-thread records, merged into the Profiler when the thread exits
+struct ThreadProfile {
+    std::vector<Stats> stats;
+    std::vector<Event> events;
+    uint64_t dropped = 0;
+    ScopedTimer* current = nullptr;
+    bool tracing;
+
+    ThreadProfile() : tracing(Profiler::instance().tracing()) {}
+    ~ThreadProfile() { Profiler::instance().merge(stats, events, dropped); }
+
+    Stats& at(std::size_t site) {
+        if (site >= stats.size()) stats.resize(site + 1);
+        return stats[site];
+    }
+
+    static ThreadProfile& local() {
+        thread_local ThreadProfile profile;
+        return profile;
+    }
+};
+
+struct Site {
+    std::size_t id;
+    explicit Site(const char* name) : id(Profiler::instance().registerSite(name)) {}
+};
+
+class ScopedTimer {
+public:
+    explicit ScopedTimer(const Site& site)
+        : site(site.id), thread(ThreadProfile::local()), parent(thread.current), begin(now()) {
+        thread.current = this;
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    ~ScopedTimer() {
+        uint64_t end = now();
+        uint64_t ticks = end - begin;
+        Stats& stats = thread.at(site);
+        stats.calls++;
+        stats.ticks += ticks;
+        stats.childTicks += childTicks;
+        if (parent) parent->childTicks += ticks;
+        thread.current = parent;
+        if (thread.tracing) {
+            if (thread.events.size() < Profiler::maxEventsPerThread) thread.events.push_back({site, begin, end});
+            else thread.dropped++;
+        }
+    }
+
+private:
+    std::size_t site;
+    ThreadProfile& thread;
+    ScopedTimer* parent;
+    uint64_t begin;
+    uint64_t childTicks = 0;
+};
+
+inline void count(const Site& site, uint64_t n) {
+    ThreadProfile::local().at(site.id).count += n;
+}
+
+} // namespace profile
+
+#define AOC_PROFILE_SCOPE(name) \
+    static const ::profile::Site AOC_PROFILE_CONCAT(aocProfileSite, __LINE__)(name); \
+    ::profile::ScopedTimer AOC_PROFILE_CONCAT(aocProfileTimer, __LINE__)(AOC_PROFILE_CONCAT(aocProfileSite, __LINE__))
+
+#define AOC_PROFILE_COUNT(name, n) \
+    do { \
+        static const ::profile::Site aocProfileCounter(name); \
+        ::profile::count(aocProfileCounter, (n)); \
+    } while (0)
+
+#endif
+
+#endif
@@ -0,0 +1,303 @@
+/* Binary snapshots of parsed puzzle inputs
+
+A snapshot holds the arrays a parsed input consists of, so that later runs can
+map the file and use the arrays in place instead of parsing the text again. The
+layout is native-endian:
+
+  header    magic "AOCSNAP", format version, kind (the day), number of sections,
+            size, modification time and checksum of the source file, checksums
+  sections  offset, size in bytes and element size of each array
+  payload   the arrays, each starting on a 64-byte boundary
+
+The header checksum covers the header and the section table, and is checked every
+time a snapshot is opened. By default that and the size and modification time of
+the source are all that is checked, so opening a current snapshot reads neither the
+source nor the payload. With verify, the payload checksum and the checksum of the
+source content are checked too, at the cost of a pass over both files; this also
+catches edits that keep the size and modification time of the source. Either way
+the solvers bounds-check the offsets they read from the payload.
+
+Snapshots are written to a temporary file that is then renamed, so a reader never
+sees a partial snapshot.
+*/
+
+#ifndef AOC_COMMON_SNAPSHOT_H
+#define AOC_COMMON_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t kind;
+    uint64_t sections;
+    uint64_t sourceSize;
+    int64_t sourceTime;
+    uint64_t sourceChecksum;
+    uint64_t payloadChecksum;
+    uint64_t headerChecksum;
+};
+
+struct SnapshotSection {
+    uint64_t offset;
+    uint64_t bytes;
+    uint64_t elementSize;
+};
+
+// 64-bit multiply-xorshift hash over 8-byte words, then the remaining bytes
+inline uint64_t snapshotChecksum(const char* data, std::size_t size, uint64_t hash = 0x9e3779b97f4a7c15UL) {
+    std::size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        hash = (hash ^ word) * 0xff51afd7ed558ccdUL;
+        hash = hash ^ (hash >> 32);
+    }
+    for (; i < size; i++) {
+        hash = (hash ^ static_cast<uint8_t>(data[i])) * 0xc4ceb9fe1a85ec53UL;
+    }
+    return hash ^ (hash >> 29);
+}
+
+// Size, modification time (ns) and content checksum of the file a snapshot was made
+// from. The checksum is 0 when it was not computed.
+struct SourceStamp {
+    uint64_t size = 0;
+    int64_t time = 0;
+    uint64_t checksum = 0;
+
+    // Same size and time, and the same checksum when both have one
+    bool matches(const SourceStamp& other) const {
+        return size == other.size && time == other.time &&
+             (checksum == 0 || other.checksum == 0 || checksum == other.checksum);
+    }
+};
+
+// The checksum takes a pass over the file, so it is only computed with content
+inline SourceStamp stampOf(const std::string& filename, bool content = false) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    struct stat info;
+    if (fd < 0 || ::fstat(fd, &info) != 0) {
+        if (fd >= 0) ::close(fd);
+        throw std::runtime_error("Failed to open file: " + filename);
+    }
+    SourceStamp stamp{static_cast<uint64_t>(info.st_size), int64_t(info.st_mtim.tv_sec) * 1000000000 + info.st_mtim.tv_nsec, 0};
+    if (content) stamp.checksum = snapshotChecksum(nullptr, 0);
+    if (content && info.st_size > 0) {
+        void* data = ::mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+            ::close(fd);
+            throw std::runtime_error("Failed to map file: " + filename);
+        }
+        stamp.checksum = snapshotChecksum(static_cast<const char*>(data), info.st_size);
+        ::munmap(data, info.st_size);
+    }
+    ::close(fd);
+    return stamp;
+}
+
+class SnapshotWriter {
+public:
+    static constexpr uint32_t version = 3;
+    static constexpr std::size_t alignment = 64;
+
+    // Offset of the payload in a snapshot with the given number of sections
+    static std::size_t payloadStart(std::size_t sections) {
+        std::size_t size = sizeof(SnapshotHeader) + sections * sizeof(SnapshotSection);
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    // The array is copied, so it does not need to outlive the writer
+    template <typename T>
+    void add(std::span<const T> array) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        payload.resize((payload.size() + alignment - 1) / alignment * alignment, 0);
+        sections.push_back({payload.size(), array.size_bytes(), sizeof(T)});
+        const char* bytes = reinterpret_cast<const char*>(array.data());
+        payload.insert(payload.end(), bytes, bytes + array.size_bytes());
+    }
+
+    void write(const std::string& filename, uint32_t kind, const SourceStamp& source) {
+        SnapshotHeader header{};
+        std::memcpy(header.magic, "AOCSNAP", 8);
+        header.version = version;
+        header.kind = kind;
+        header.sections = sections.size();
+        header.sourceSize = source.size;
+        header.sourceTime = source.time;
+        header.sourceChecksum = source.checksum;
+
+        // Offsets are made relative to the start of the file
+        std::size_t start = payloadStart(sections.size());
+        std::vector<SnapshotSection> table = sections;
+        for (auto& section : table) section.offset = section.offset + start;
+
+        header.payloadChecksum = snapshotChecksum(payload.data(), payload.size());
+        header.headerChecksum = 0;
+        uint64_t checksum = snapshotChecksum(reinterpret_cast<const char*>(&header), sizeof(header));
+        header.headerChecksum = snapshotChecksum(reinterpret_cast<const char*>(table.data()),
+             table.size() * sizeof(SnapshotSection), checksum);
+
+        std::string temporary = filename + ".tmp";
+        std::FILE* file = std::fopen(temporary.c_str(), "wb");
+        if (!file) {
+            throw std::runtime_error("Failed to open file: " + temporary);
+        }
+        std::vector<char> padding(start - sizeof(header) - table.size() * sizeof(SnapshotSection), 0);
+        bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+        ok = ok && std::fwrite(table.data(), sizeof(SnapshotSection), table.size(), file) == table.size();
+        ok = ok && std::fwrite(padding.data(), 1, padding.size(), file) == padding.size();
+        ok = ok && std::fwrite(payload.data(), 1, payload.size(), file) == payload.size();
+        ok = (std::fclose(file) == 0) && ok;
+        if (!ok || std::rename(temporary.c_str(), filename.c_str()) != 0) {
+            std::remove(temporary.c_str());
+            throw std::runtime_error("Failed to write file: " + filename);
+        }
+    }
+
+private:
+    std::vector<SnapshotSection> sections;
+    std::vector<char> payload;
+};
+
+// A snapshot mapped read-only; the arrays are views into the mapping. The payload
+// checksum is only checked with verify.
+class Snapshot {
+public:
+    Snapshot(const std::string& filename, uint32_t kind, bool verify = false) : filename_(filename) {
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Failed to open file: " + filename);
+        }
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(SnapshotHeader))) {
+            ::close(fd);
+            throw std::runtime_error("Invalid snapshot: " + filename);
+        }
+        size_ = info.st_size;
+        void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            throw std::runtime_error("Failed to map file: " + filename);
+        }
+        data_ = static_cast<const char*>(data);
+        if (!validate(kind, verify)) {
+            unmap();
+            throw std::runtime_error("Invalid snapshot: " + filename);
+        }
+    }
+
+    Snapshot(Snapshot&& other) noexcept
+        : filename_(std::move(other.filename_)), data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0)) {}
+
+    Snapshot& operator=(Snapshot&& other) noexcept {
+        if (this != &other) {
+            unmap();
+            filename_ = std::move(other.filename_);
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    Snapshot(const Snapshot&) = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+    ~Snapshot() { unmap(); }
+
+    const SnapshotHeader& header() const {
+        return *reinterpret_cast<const SnapshotHeader*>(data_);
+    }
+
+    SourceStamp source() const {
+        return {header().sourceSize, header().sourceTime, header().sourceChecksum};
+    }
+
+    std::size_t sections() const { return header().sections; }
+
+    template <typename T>
+    std::span<const T> section(std::size_t index) const {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (index >= sections() || table()[index].elementSize != sizeof(T)) {
+            throw std::runtime_error("Invalid snapshot section in " + filename_);
+        }
+        const SnapshotSection& s = table()[index];
+        return std::span<const T>(reinterpret_cast<const T*>(data_ + s.offset), s.bytes / sizeof(T));
+    }
+
+private:
+    const SnapshotSection* table() const {
+        return reinterpret_cast<const SnapshotSection*>(data_ + sizeof(SnapshotHeader));
+    }
+
+    bool validate(uint32_t kind, bool verify) const {
+        SnapshotHeader header;
+        std::memcpy(&header, data_, sizeof(header));
+        if (std::memcmp(header.magic, "AOCSNAP", 8) != 0 || header.version != SnapshotWriter::version ||
+             header.kind != kind) {
+            return false;
+        }
+        if (header.sections > (size_ - sizeof(header)) / sizeof(SnapshotSection)) return false;
+        uint64_t expected = header.headerChecksum;
+        header.headerChecksum = 0;
+        uint64_t checksum = snapshotChecksum(reinterpret_cast<const char*>(&header), sizeof(header));
+        checksum = snapshotChecksum(reinterpret_cast<const char*>(table()), header.sections * sizeof(SnapshotSection), checksum);
+        if (checksum != expected) return false;
+
+        std::size_t start = SnapshotWriter::payloadStart(header.sections);
+        if (start > size_) return false;
+        for (std::size_t i = 0; i < header.sections; i++) {
+            const SnapshotSection& s = table()[i];
+            if (s.elementSize == 0 || s.offset % SnapshotWriter::alignment != 0 || s.offset < start ||
+                 s.offset > size_ || s.bytes > size_ - s.offset || s.bytes % s.elementSize != 0) {
+                return false;
+            }
+        }
+        return !verify || snapshotChecksum(data_ + start, size_ - start) == header.payloadChecksum;
+    }
+
+    void unmap() {
+        if (data_) ::munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+    }
+
+    std::string filename_;
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+// Snapshot of inputfile, kept at snapshotfile. When that is missing, invalid or was
+// made from another version of the input, write(inputfile, snapshotfile) parses the
+// input and writes it again. write should stamp the snapshot with the checksum of the
+// input (stampOf(inputfile, true)), since it reads the whole input anyway.
+template <typename Write>
+Snapshot openSnapshotCache(const std::string& inputfile, const std::string& snapshotfile, uint32_t kind, Write&& write,
+     bool verify = false) {
+    SourceStamp source = stampOf(inputfile, verify);
+    try {
+        Snapshot snapshot(snapshotfile, kind, verify);
+        if (snapshot.source().matches(source)) return snapshot;
+    }
+    catch (const std::runtime_error&) {
+        // Missing or invalid: write it below
+    }
+    write(inputfile, snapshotfile);
+    return Snapshot(snapshotfile, kind);
+}
+
+#endif
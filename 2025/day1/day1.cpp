@@ -62,41 +62,49 @@ Analyze the rotations in your attached document. What's the actual password to o
 
 */
 
-#include <iostream>
-#include <assert.h>
-#include <fstream>
+#include "day1.h"
 
-enum Direction {LEFT, RIGHT};
+#include <assert.h>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+
+#include "../common/input.h"
+#include "../common/profile.h"
+
+namespace day1 {
+
+std::pair<Direction, unsigned int> parseRotation(std::string_view line, const std::string& filename) {
+    char dirChar = line[0];
+    Direction dir;
+    if (dirChar == 'L') {
+        dir = LEFT;
+    } else if (dirChar == 'R') {
+        dir = RIGHT;
+    } else {
+        throw std::runtime_error("Invalid direction in " + filename + ", line: " + std::string(line));
+    }
+    return {dir, parseNumber<unsigned int>(line.substr(1))};
+}
 
 std::pair<std::vector<Direction>, std::vector<unsigned int>> readPuzzleInput(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Failed to open file: " + filename);
-    }
+    AOC_PROFILE_SCOPE("day1::readPuzzleInput");
+    LineReader file(filename);
 
     std::vector<Direction> directions;
     std::vector<unsigned int> numbers;
-    std::string line;
+    std::string_view line;
 
-    while (std::getline(file, line)) {
+    while (file.next(line)) {
         if (line.empty()) continue;
 
-        char dirChar = line[0];
-        Direction dir;
-        if (dirChar == 'L') {
-            dir = LEFT;
-        } else if (dirChar == 'R') {
-            dir = RIGHT;
-        } else {
-            throw std::runtime_error("Invalid direction in " + filename + ", line: " + line);
-        }
-
-        unsigned int num = std::stoul(line.substr(1));
+        auto [dir, num] = parseRotation(line, filename);
 
         directions.push_back(dir);
         numbers.push_back(num);
     }
 
+    AOC_PROFILE_COUNT("day1::readPuzzleInput", directions.size());
     return {directions, numbers};
 }
 
@@ -123,53 +131,224 @@ unsigned int rotateLock(unsigned int start,  Direction dir, unsigned int positio
     }
 }
 
-unsigned int solvePuzzle(unsigned int start, std::string inputfile) {
-
-    auto input = readPuzzleInput(inputfile);
+// Number of clicks during a rotation that leave the dial pointing at 0, including
+// the last one. Counted arithmetically, so full laps cost nothing.
+unsigned int countZeroCrossings(unsigned int start, Direction dir, unsigned int positions) {
+    if (dir == Direction::RIGHT) {
+        return (start + positions) / 100;
+    }
+    // Turning left, the first 0 is reached after start clicks (a full lap when starting at 0)
+    unsigned int first = (start == 0) ? 100 : start;
+    if (positions < first) {
+        return 0;
+    }
+    return (positions - first) / 100 + 1;
+}
 
+unsigned long int countZeros(unsigned int start, const std::pair<std::vector<Direction>, std::vector<unsigned int>>& input,
+     CountMode mode) {
     // Rotate
     unsigned int position = start;
-    unsigned int num_zeros = 0;
+    unsigned long int num_zeros = 0;
     for (int i = 0; i < input.first.size(); i++) {
+        if (mode == CROSSINGS) {
+            num_zeros = num_zeros + countZeroCrossings(position, input.first[i], input.second[i]);
+        }
         position = rotateLock(position, input.first[i], input.second[i]);
-        if (position == 0) {
+        if (mode == LANDINGS && position == 0) {
             num_zeros = num_zeros + 1;
         }
     }
+    AOC_PROFILE_COUNT("day1::rotateLock", input.first.size());
     return num_zeros;
 }
 
-int main() {
+unsigned long int solvePuzzle(unsigned int start, std::string inputfile, CountMode mode) {
+    AOC_PROFILE_SCOPE("day1::solvePuzzle");
+    return countZeros(start, readPuzzleInput(inputfile), mode);
+}
+
+// Rotations are translations mod 100: starting at p, the dial is at (p + offset_i) % 100
+// after i rotations, where offset_i is the position reached starting from 0. So the
+// zeros for every start follow from a histogram of the offsets, in a single pass.
+DialTransfer buildTransfer(const Direction* dirs, const unsigned int* numbers, std::size_t count) {
+    std::array<unsigned long int, 100> histogram{};
+    unsigned int offset = 0;
+    for (std::size_t i = 0; i < count; i++) {
+        offset = rotateLock(offset, dirs[i], numbers[i]);
+        histogram[offset]++;
+    }
+    AOC_PROFILE_COUNT("day1::rotateLock", count);
 
-    // Check tests for roatateLock pass
-    assert(rotateLock(11, Direction::RIGHT, 8) == 19);
-    assert(rotateLock(19, Direction::LEFT, 19) == 0);
-    assert(rotateLock(0, Direction::LEFT, 1) == 99);
-    assert(rotateLock(99, Direction::RIGHT, 1) == 0);
-    assert(rotateLock(5, Direction::LEFT, 10) == 95);
-    std::cout << "All tests for rotateLock pass" << std::endl;
+    DialTransfer transfer;
+    for (unsigned int p = 0; p < 100; p++) {
+        transfer.end[p] = (p + offset) % 100;
+        transfer.zeros[p] = histogram[(100 - p) % 100];
+    }
+    return transfer;
+}
 
-    // Check test for readPuzzleInput passes
-    std::vector<unsigned int> expected_positions = {68, 30, 48, 5, 60, 55, 1, 99, 14, 82};
-    std::vector<Direction> expected_dirs = {Direction::LEFT, Direction::LEFT, Direction::RIGHT, Direction::LEFT, Direction::RIGHT,
-    Direction::LEFT, Direction::LEFT, Direction::LEFT, Direction::RIGHT, Direction::LEFT};
-    auto testinput = readPuzzleInput("testinput_day1.txt");
-    assert(testinput.first.size() == 10 && testinput.second.size() == 10);
-    for (int i = 0; i < 10; i++) {
-        assert(testinput.first[i] == expected_dirs[i]);
-        assert(testinput.second[i] == expected_positions[i]);
+// Transfer of the rotations of first followed by the ones of second
+DialTransfer composeTransfers(const DialTransfer& first, const DialTransfer& second) {
+    DialTransfer result;
+    for (unsigned int p = 0; p < 100; p++) {
+        result.end[p] = second.end[first.end[p]];
+        result.zeros[p] = first.zeros[p] + second.zeros[first.end[p]];
     }
-    std::cout << "Test for readPuzzleInput passes" << std::endl;
+    return result;
+}
 
-    // Check test for solvePuzzle passes
-    assert(solvePuzzle(50, "testinput_day1.txt") == 3);
-    std::cout << "Test for solvePuzzle passes" << std::endl;
+// Same result as solvePuzzle. The rotations are split into chunks whose transfers
+// are built in parallel, then combined pairwise in a parallel tree reduction.
+unsigned long int solvePuzzleParallel(unsigned int start, std::string inputfile,
+     unsigned int threads, std::size_t chunks) {
+    // The transfers only cover the 100 positions of the dial
+    if (start >= 100) {
+        throw std::invalid_argument("Invalid start position: " + std::to_string(start));
+    }
+    auto input = readPuzzleInput(inputfile);
+    const std::size_t count = input.first.size();
+    if (chunks == 0) chunks = 4 * std::size_t(threads);
+    chunks = std::max<std::size_t>(1, std::min(chunks, count));
+
+    std::vector<DialTransfer> transfers(chunks);
+    parallelFor(chunks, threads, [&](std::size_t chunk, unsigned int) {
+        std::size_t begin = count * chunk / chunks;
+        std::size_t end = count * (chunk + 1) / chunks;
+        transfers[chunk] = buildTransfer(input.first.data() + begin, input.second.data() + begin, end - begin);
+    });
+
+    // Composition is associative, so the order of the pairs within a level does not matter
+    for (std::size_t stride = 1; stride < chunks; stride *= 2) {
+        parallelFor((chunks + 2 * stride - 1) / (2 * stride), threads, [&](std::size_t pair, unsigned int) {
+            std::size_t left = 2 * stride * pair;
+            std::size_t right = left + stride;
+            if (right < chunks) transfers[left] = composeTransfers(transfers[left], transfers[right]);
+        });
+    }
+    return transfers[0].zeros[start];
+}
 
-    // Solve the puzzle
-    unsigned int solution = solvePuzzle(50, "input_day1.txt");
-    std::cout << "The solution for the puzzle is: " << solution << std::endl;
-    
-    return 0;
+void applyRotation(DialState& state, Direction dir, unsigned int positions) {
+    state.position = rotateLock(state.position, dir, positions);
+    if (state.position == 0) {
+        state.zeros = state.zeros + 1;
+    }
+    state.records = state.records + 1;
+}
 
+// Solve the puzzle reading one rotation at a time from inputfile ("-" for stdin),
+// in constant memory. The rotations already accounted for in state are not counted
+// again, so a saved state resumes the log where it stopped: the input seeks to
+// state.offset when it can, and otherwise the first state.records rotations are
+// read and skipped. A last line without its '\n' is left in state.pending instead
+// of being counted, so a record that is only partly written is read whole by the
+// next run. report is called with the running state every reportEvery rotations
+// (0 disables it).
+DialState solveStream(const std::string& inputfile, DialState state,
+     unsigned long int reportEvery, const std::function<void(const DialState&)>& report) {
+    LineReader file(inputfile);
+    std::string_view line;
+    unsigned long int skip = state.records;
+    if (skip > 0 && state.offset > 0 && file.seek(state.offset)) skip = 0;
+    state.pending.clear();
+    while (file.next(line)) {
+        if (!file.terminated()) {
+            if (skip == 0) state.pending = line;
+            break;
+        }
+        if (line.empty()) continue;
+        if (skip > 0) {
+            skip--;
+            continue;
+        }
+        auto [dir, num] = parseRotation(line, inputfile);
+        applyRotation(state, dir, num);
+        state.offset = file.offset();
+        if (reportEvery > 0 && report && state.records % reportEvery == 0) {
+            report(state);
+        }
+    }
+    return state;
+}
+
+// Count the pending line of a log that is known to be complete
+DialState finishStream(DialState state, const std::string& inputfile) {
+    if (!state.pending.empty()) {
+        auto [dir, num] = parseRotation(state.pending, inputfile);
+        applyRotation(state, dir, num);
+        state.offset = state.offset + state.pending.size();
+        state.pending.clear();
+    }
+    return state;
+}
+
+// Checkpoints are a single line "position zeros records offset"
+void saveCheckpoint(const DialState& state, const std::string& filename) {
+    // Write to a temporary file first so a crash never leaves a truncated checkpoint
+    std::string tmpname = filename + ".tmp";
+    FILE* file = std::fopen(tmpname.c_str(), "w");
+    if (!file) {
+        throw std::runtime_error("Failed to open file: " + tmpname);
+    }
+    std::fprintf(file, "%u %lu %lu %lu\n", state.position, state.zeros, state.records, state.offset);
+    if (std::fclose(file) != 0 || std::rename(tmpname.c_str(), filename.c_str()) != 0) {
+        throw std::runtime_error("Failed to write checkpoint: " + filename);
+    }
+}
+
+// Load a checkpoint, or start from the given position if there is none yet.
+// Checkpoints without an offset are resumed by skipping records rotations.
+DialState loadCheckpoint(const std::string& filename, unsigned int start) {
+    DialState state;
+    state.position = start;
+    FILE* file = std::fopen(filename.c_str(), "r");
+    if (!file) return state;
+    int fields = std::fscanf(file, "%u %lu %lu %lu", &state.position, &state.zeros, &state.records, &state.offset);
+    std::fclose(file);
+    if (fields < 3 || state.position >= 100) {
+        throw std::runtime_error("Invalid checkpoint: " + filename);
+    }
+    return state;
+}
+
+void writeSnapshot(const std::string& inputfile, const std::string& snapshotfile) {
+    SourceStamp source = stampOf(inputfile, true);
+    auto input = readPuzzleInput(inputfile);
+    std::vector<uint32_t> rotations(input.first.size());
+    for (std::size_t i = 0; i < rotations.size(); i++) {
+        if (input.second[i] >= (1U << 31)) {
+            throw std::runtime_error("Rotation too large for a snapshot in " + inputfile);
+        }
+        rotations[i] = (input.second[i] << 1) | (input.first[i] == RIGHT ? 1 : 0);
+    }
+    SnapshotWriter writer;
+    writer.add(std::span<const uint32_t>(rotations));
+    writer.write(snapshotfile, 1, source);
+}
+
+Snapshot openSnapshot(const std::string& inputfile, const std::string& snapshotfile, bool verify) {
+    return openSnapshotCache(inputfile, snapshotfile, 1, writeSnapshot, verify);
+}
+
+unsigned long int solveSnapshot(const Snapshot& snapshot, unsigned int start, CountMode mode) {
+    AOC_PROFILE_SCOPE("day1::solveSnapshot");
+    unsigned int position = start;
+    unsigned long int num_zeros = 0;
+    auto rotations = snapshot.section<uint32_t>(0);
+    for (auto rotation : rotations) {
+        Direction dir = (rotation & 1) ? RIGHT : LEFT;
+        unsigned int positions = rotation >> 1;
+        if (mode == CROSSINGS) {
+            num_zeros = num_zeros + countZeroCrossings(position, dir, positions);
+        }
+        position = rotateLock(position, dir, positions);
+        if (mode == LANDINGS && position == 0) {
+            num_zeros = num_zeros + 1;
+        }
+    }
+    AOC_PROFILE_COUNT("day1::rotateLock", rotations.size());
+    return num_zeros;
 }
 
+} // namespace day1
@@ -0,0 +1,78 @@
+/* Day 1: Secret Entrance
+https://adventofcode.com/2025/day/1
+*/
+
+#ifndef AOC_2025_DAY1_H
+#define AOC_2025_DAY1_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "../common/parallel.h"
+#include "../common/snapshot.h"
+
+namespace day1 {
+
+enum Direction {LEFT, RIGHT};
+
+std::pair<Direction, unsigned int> parseRotation(std::string_view line, const std::string& filename);
+std::pair<std::vector<Direction>, std::vector<unsigned int>> readPuzzleInput(const std::string& filename);
+
+unsigned int rotateLock(unsigned int start,  Direction dir, unsigned int positions);
+unsigned int countZeroCrossings(unsigned int start, Direction dir, unsigned int positions);
+
+// LANDINGS counts the rotations that end on 0, CROSSINGS every click that reaches 0
+enum CountMode {LANDINGS, CROSSINGS};
+
+// Zeros counted over rotations as returned by readPuzzleInput
+unsigned long int countZeros(unsigned int start, const std::pair<std::vector<Direction>, std::vector<unsigned int>>& input,
+     CountMode mode = LANDINGS);
+unsigned long int solvePuzzle(unsigned int start, std::string inputfile, CountMode mode = LANDINGS);
+
+// Effect of a sequence of rotations for each of the 100 start positions: where the
+// dial ends and how many times it lands on 0. Transfers of consecutive chunks can be
+// composed, which lets chunks of the input be processed independently.
+struct DialTransfer {
+    std::array<uint8_t, 100> end;
+    std::array<unsigned long int, 100> zeros;
+};
+
+DialTransfer buildTransfer(const Direction* dirs, const unsigned int* numbers, std::size_t count);
+DialTransfer composeTransfers(const DialTransfer& first, const DialTransfer& second);
+unsigned long int solvePuzzleParallel(unsigned int start, std::string inputfile,
+     unsigned int threads = defaultThreadCount(), std::size_t chunks = 0);
+
+// State of a streamed solve, enough to resume it later. offset is the byte offset in
+// the input just past the last rotation counted in records (0 when unknown). pending
+// is a last line without its '\n', which is not counted yet since the log may still
+// be being written; it is not saved in checkpoints.
+struct DialState {
+    unsigned int position = 50;
+    unsigned long int zeros = 0;
+    unsigned long int records = 0;
+    unsigned long int offset = 0;
+    std::string pending;
+};
+
+void applyRotation(DialState& state, Direction dir, unsigned int positions);
+DialState solveStream(const std::string& inputfile, DialState state,
+     unsigned long int reportEvery = 0, const std::function<void(const DialState&)>& report = nullptr);
+DialState finishStream(DialState state, const std::string& inputfile);
+void saveCheckpoint(const DialState& state, const std::string& filename);
+DialState loadCheckpoint(const std::string& filename, unsigned int start);
+
+// Binary snapshot of the rotations (see common/snapshot.h), one uint32_t per rotation
+// holding positions << 1 | direction
+void writeSnapshot(const std::string& inputfile, const std::string& snapshotfile);
+// Snapshot of inputfile at snapshotfile, written first when it is missing or stale
+Snapshot openSnapshot(const std::string& inputfile, const std::string& snapshotfile, bool verify = false);
+unsigned long int solveSnapshot(const Snapshot& snapshot, unsigned int start, CountMode mode = LANDINGS);
+
+} // namespace day1
+
+#endif
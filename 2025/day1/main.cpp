@@ -0,0 +1,58 @@
+/* Command line interface for Day 1
+
+Usage: day1 [input]
+       day1 --stream <file|-> [--every N] [--checkpoint path]
+
+Without options the puzzle is solved for input (default input_day1.txt). With
+--stream the rotations are read one at a time, reporting the running totals
+every N rotations and saving them to the checkpoint to resume from later.
+*/
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "day1.h"
+#include "../common/input.h"
+
+using namespace day1;
+
+int runStream(int argc, char** argv) {
+    std::string inputfile = argv[2];
+    unsigned long int every = 0;
+    std::string checkpoint;
+    for (int i = 3; i + 1 < argc; i += 2) {
+        std::string option = argv[i];
+        if (option == "--every") every = parseNumber<unsigned long int>(argv[i + 1]);
+        else if (option == "--checkpoint") checkpoint = argv[i + 1];
+        else throw std::runtime_error("Unknown option: " + option);
+    }
+
+    DialState state = checkpoint.empty() ? DialState() : loadCheckpoint(checkpoint, 50);
+    state = solveStream(inputfile, state, every, [&](const DialState& s) {
+        std::cout << s.records << " rotations, " << s.zeros << " zeros, position " << s.position << "\n";
+        if (!checkpoint.empty()) saveCheckpoint(s, checkpoint);
+    });
+    // The checkpoint leaves out an unterminated last line, which may still grow
+    if (!checkpoint.empty()) saveCheckpoint(state, checkpoint);
+    state = finishStream(state, inputfile);
+    std::cout << "The solution for the puzzle is: " << state.zeros << std::endl;
+    return 0;
+}
+
+int main(int argc, char** argv) {
+
+    if (argc >= 3 && std::string(argv[1]) == "--stream") {
+        return runStream(argc, argv);
+    }
+
+    std::string inputfile = (argc >= 2) ? argv[1] : "input_day1.txt";
+
+    unsigned long int solution = solvePuzzle(50, inputfile);
+    std::cout << "The solution for the puzzle is: " << solution << std::endl;
+
+    unsigned long int crossings = solvePuzzle(50, inputfile, CROSSINGS);
+    std::cout << "The solution counting every click on 0 is: " << crossings << std::endl;
+
+    return 0;
+}
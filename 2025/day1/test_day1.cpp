@@ -0,0 +1,221 @@
+/* Tests for Day 1, run from the day1 directory */
+
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "day1.h"
+#include "../common/check.h"
+
+using namespace day1;
+
+int main() {
+
+    const std::string checkpointFile = scratchFile("checkpoint_day1.tmp");
+    const std::string resumeFile = scratchFile("resume_day1.tmp");
+    const std::string snapshotFile = scratchFile("snapshot_day1.tmp");
+    const std::string editedFile = scratchFile("edited_day1.tmp");
+
+    // Check tests for roatateLock pass
+    CHECK(rotateLock(11, Direction::RIGHT, 8) == 19);
+    CHECK(rotateLock(19, Direction::LEFT, 19) == 0);
+    CHECK(rotateLock(0, Direction::LEFT, 1) == 99);
+    CHECK(rotateLock(99, Direction::RIGHT, 1) == 0);
+    CHECK(rotateLock(5, Direction::LEFT, 10) == 95);
+    std::cout << "All tests for rotateLock pass" << std::endl;
+
+    // Check test for readPuzzleInput passes
+    std::vector<unsigned int> expected_positions = {68, 30, 48, 5, 60, 55, 1, 99, 14, 82};
+    std::vector<Direction> expected_dirs = {Direction::LEFT, Direction::LEFT, Direction::RIGHT, Direction::LEFT, Direction::RIGHT,
+    Direction::LEFT, Direction::LEFT, Direction::LEFT, Direction::RIGHT, Direction::LEFT};
+    auto testinput = readPuzzleInput("testinput_day1.txt");
+    CHECK(testinput.first.size() == 10 && testinput.second.size() == 10);
+    for (int i = 0; i < 10; i++) {
+        CHECK(testinput.first[i] == expected_dirs[i]);
+        CHECK(testinput.second[i] == expected_positions[i]);
+    }
+    std::cout << "Test for readPuzzleInput passes" << std::endl;
+
+    // Check tests for countZeroCrossings pass
+    CHECK(countZeroCrossings(50, Direction::LEFT, 68) == 1);
+    CHECK(countZeroCrossings(52, Direction::RIGHT, 48) == 1);
+    CHECK(countZeroCrossings(50, Direction::RIGHT, 1000) == 10);
+    CHECK(countZeroCrossings(50, Direction::LEFT, 1000) == 10);
+    CHECK(countZeroCrossings(0, Direction::LEFT, 1) == 0);
+    CHECK(countZeroCrossings(0, Direction::RIGHT, 99) == 0);
+    CHECK(countZeroCrossings(0, Direction::LEFT, 100) == 1);
+    CHECK(countZeroCrossings(0, Direction::RIGHT, 100) == 1);
+    CHECK(countZeroCrossings(0, Direction::LEFT, 250) == 2);
+    CHECK(countZeroCrossings(0, Direction::LEFT, 0) == 0);
+    CHECK(countZeroCrossings(5, Direction::LEFT, 4) == 0);
+    CHECK(countZeroCrossings(5, Direction::LEFT, 5) == 1);
+    CHECK(countZeroCrossings(5, Direction::LEFT, 105) == 2);
+    CHECK(countZeroCrossings(95, Direction::RIGHT, 4) == 0);
+    CHECK(countZeroCrossings(95, Direction::RIGHT, 5) == 1);
+    CHECK(countZeroCrossings(95, Direction::RIGHT, 4000005) == 40001);
+    for (unsigned int start = 0; start < 100; start++) {
+        for (unsigned int positions = 0; positions < 350; positions++) {
+            // Click through the positions one at a time
+            unsigned int leftZeros = 0, rightZeros = 0;
+            unsigned int leftPosition = start, rightPosition = start;
+            for (unsigned int i = 0; i < positions; i++) {
+                leftPosition = rotateLock(leftPosition, Direction::LEFT, 1);
+                rightPosition = rotateLock(rightPosition, Direction::RIGHT, 1);
+                leftZeros = leftZeros + (leftPosition == 0);
+                rightZeros = rightZeros + (rightPosition == 0);
+            }
+            CHECK(countZeroCrossings(start, Direction::LEFT, positions) == leftZeros);
+            CHECK(countZeroCrossings(start, Direction::RIGHT, positions) == rightZeros);
+        }
+    }
+    std::cout << "All tests for countZeroCrossings pass" << std::endl;
+
+    // Check test for solvePuzzle passes
+    CHECK(solvePuzzle(50, "testinput_day1.txt") == 3);
+    CHECK(solvePuzzle(50, "testinput_day1.txt", CROSSINGS) == 6);
+    CHECK(countZeros(50, readPuzzleInput("testinput_day1.txt")) == 3);
+    CHECK(countZeros(50, readPuzzleInput("testinput_day1.txt"), CROSSINGS) == 6);
+    std::cout << "Test for solvePuzzle passes" << std::endl;
+
+    // Check tests for the streaming solver pass
+    // The test input has no '\n' after its last rotation, which is pending until the stream is finished
+    DialState streamed = solveStream("testinput_day1.txt", DialState());
+    CHECK(streamed.records == 9 && streamed.pending == "L82");
+    streamed = finishStream(streamed, "testinput_day1.txt");
+    CHECK(streamed.zeros == 3 && streamed.records == 10 && streamed.position == 32 && streamed.pending.empty());
+    std::vector<unsigned long int> reported;
+    solveStream("testinput_day1.txt", DialState(), 3, [&](const DialState& s) { reported.push_back(s.records); });
+    CHECK((reported == std::vector<unsigned long int>{3, 6, 9}));
+    DialState partial;
+    for (int i = 0; i < 4; i++) applyRotation(partial, expected_dirs[i], expected_positions[i]);
+    saveCheckpoint(partial, checkpointFile);
+    DialState resumed = finishStream(solveStream("testinput_day1.txt", loadCheckpoint(checkpointFile, 50)), "testinput_day1.txt");
+    std::remove(checkpointFile.c_str());
+    CHECK(resumed.zeros == streamed.zeros && resumed.records == streamed.records && resumed.position == streamed.position);
+    CHECK(loadCheckpoint(checkpointFile, 50).records == 0);
+    // A checkpoint with an offset seeks there instead of reading the rotations before it
+    CHECK(streamed.offset == std::filesystem::file_size("testinput_day1.txt"));
+    DialState third;
+    solveStream("testinput_day1.txt", DialState(), 3, [&](const DialState& s) { if (s.records == 3) third = s; });
+    CHECK(third.offset == 12);
+    saveCheckpoint(third, checkpointFile);
+    DialState loaded = loadCheckpoint(checkpointFile, 50);
+    std::remove(checkpointFile.c_str());
+    CHECK(loaded.offset == third.offset && loaded.records == 3);
+    resumed = finishStream(solveStream("testinput_day1.txt", loaded), "testinput_day1.txt");
+    CHECK(resumed.zeros == streamed.zeros && resumed.records == streamed.records && resumed.position == streamed.position);
+    // Resuming at the offset does not read the skipped rotations, which are not even valid here
+    {
+        std::FILE* file = std::fopen(resumeFile.c_str(), "wb");
+        std::fputs("junk\njunk\njunk\nL5\nR60\nL55\nL1\n", file);
+        std::fclose(file);
+        DialState skipped;
+        skipped.records = 3;
+        skipped.offset = 15;
+        CHECK(solveStream(resumeFile, skipped).records == 7);
+        std::remove(resumeFile.c_str());
+    }
+    // A record cut off at the end of the log is neither counted nor checkpointed, and is
+    // read whole once the rest of it has been written
+    {
+        std::FILE* file = std::fopen(resumeFile.c_str(), "wb");
+        std::fputs("L68\nL30\nR4", file);
+        std::fclose(file);
+        DialState cut = solveStream(resumeFile, DialState());
+        CHECK(cut.records == 2 && cut.offset == 8 && cut.pending == "R4");
+        saveCheckpoint(cut, checkpointFile);
+        file = std::fopen(resumeFile.c_str(), "ab");
+        std::fputs("8\nL5\n", file);
+        std::fclose(file);
+        DialState whole = solveStream(resumeFile, DialState());
+        DialState continued = solveStream(resumeFile, loadCheckpoint(checkpointFile, 50));
+        CHECK(continued.records == 4 && continued.position == whole.position && continued.zeros == whole.zeros);
+        CHECK(continued.offset == whole.offset && continued.pending.empty());
+        std::remove(checkpointFile.c_str());
+        std::remove(resumeFile.c_str());
+    }
+    std::cout << "Tests for solveStream pass" << std::endl;
+
+    // Check tests for the parallel solver pass
+    for (unsigned int threads = 1; threads <= 4; threads++) {
+        for (std::size_t chunks = 1; chunks <= 12; chunks++) {
+            CHECK(solvePuzzleParallel(50, "testinput_day1.txt", threads, chunks) == 3);
+        }
+        CHECK(solvePuzzleParallel(50, "input_day1.txt", threads, 37) == solvePuzzle(50, "input_day1.txt"));
+    }
+    for (unsigned int start = 0; start < 100; start += 11) {
+        CHECK(solvePuzzleParallel(start, "input_day1.txt") == solvePuzzle(start, "input_day1.txt"));
+    }
+    bool rejected = false;
+    try {
+        solvePuzzleParallel(100, "testinput_day1.txt");
+    }
+    catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    CHECK(rejected);
+    std::cout << "Tests for solvePuzzleParallel pass" << std::endl;
+
+    // Check tests for snapshots pass
+    std::remove(snapshotFile.c_str());
+    for (auto file : {"testinput_day1.txt", "input_day1.txt"}) {
+        Snapshot snapshot = openSnapshot(file, snapshotFile);
+        CHECK(solveSnapshot(snapshot, 50) == solvePuzzle(50, file));
+        CHECK(solveSnapshot(snapshot, 50, CROSSINGS) == solvePuzzle(50, file, CROSSINGS));
+    }
+    {
+        // A current snapshot is used as it is, a damaged one is rejected and written again
+        SourceStamp written = stampOf(snapshotFile);
+        CHECK(openSnapshot("input_day1.txt", snapshotFile).source().matches(stampOf("input_day1.txt", true)));
+        CHECK(stampOf(snapshotFile).matches(written));
+        std::FILE* file = std::fopen(snapshotFile.c_str(), "r+b");
+        std::fseek(file, -1, SEEK_END);
+        int last = std::fgetc(file);
+        std::fseek(file, -1, SEEK_END);
+        std::fputc(last ^ 1, file);
+        std::fclose(file);
+        // The payload checksum is only checked when asked for
+        Snapshot unchecked(snapshotFile, 1);
+        bool rejected = false;
+        try {
+            Snapshot damaged(snapshotFile, 1, true);
+        }
+        catch (const std::runtime_error&) {
+            rejected = true;
+        }
+        CHECK(rejected);
+        CHECK(solveSnapshot(openSnapshot("input_day1.txt", snapshotFile, true), 50) == solvePuzzle(50, "input_day1.txt"));
+        rejected = false;
+        try {
+            Snapshot other(snapshotFile, 2);
+        }
+        catch (const std::runtime_error&) {
+            rejected = true;
+        }
+        CHECK(rejected);
+    }
+    {
+        // An edit that keeps the size and modification time of the input goes unnoticed
+        // unless the content is verified
+        auto writeInput = [&](const char* text) {
+            std::FILE* file = std::fopen(editedFile.c_str(), "wb");
+            std::fputs(text, file);
+            std::fclose(file);
+        };
+        writeInput("L50\nR20\n");
+        auto time = std::filesystem::last_write_time(editedFile);
+        CHECK(solveSnapshot(openSnapshot(editedFile, snapshotFile), 50) == 1);
+        writeInput("L40\nR20\n");
+        std::filesystem::last_write_time(editedFile, time);
+        CHECK(solveSnapshot(openSnapshot(editedFile, snapshotFile), 50) == 1);
+        CHECK(solveSnapshot(openSnapshot(editedFile, snapshotFile, true), 50) == 0);
+        std::remove(editedFile.c_str());
+    }
+    std::remove(snapshotFile.c_str());
+    std::cout << "Tests for snapshots pass" << std::endl;
+
+    return 0;
+}
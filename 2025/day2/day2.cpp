@@ -39,43 +39,49 @@ What do you get if you add up all of the invalid IDs?
 
 */
 
-#include <iostream>
+#include "day2.h"
+
+#include <algorithm>
 #include <assert.h>
-#include <fstream>
-#include <sstream>
-#include <numeric>
+#include <stdexcept>
+
+#include "../common/input.h"
+#include "../common/profile.h"
+
+namespace day2 {
 
 std::vector<std::pair<unsigned long int, unsigned long int>> readPuzzleInput(std::string filename){
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Failed to open file: " + filename);
-    }
+    AOC_PROFILE_SCOPE("day2::readPuzzleInput");
+    LineReader file(filename);
 
     // Read file
-    std::string line;
-    std::getline(file, line);     // read the single, long line
+    std::string_view line;
+    file.next(line);     // read the single, long line
 
     std::vector<std::pair<unsigned long int, unsigned long int>> ranges;
 
-    std::stringstream ss(line);
-    std::string item;
+    FieldSplitter items(line, ',');
+    std::string_view item;
 
-    while (std::getline(ss, item, ',')) {   // split by commas
+    while (items.next(item)) {   // split by commas
+        if (item.empty()) continue;
         // item looks like "1517536-173648713"
         auto dashPos = item.find('-');
-        if (dashPos == std::string::npos) {
-            throw std::runtime_error("Invalid item: " + item);
+        if (dashPos == std::string_view::npos) {
+            throw std::runtime_error("Invalid item: " + std::string(item));
         }
-        unsigned long int first  = std::stoul(item.substr(0, dashPos));
-        unsigned long int second = std::stoul(item.substr(dashPos + 1));
+        unsigned long int first  = parseNumber<unsigned long int>(item.substr(0, dashPos));
+        unsigned long int second = parseNumber<unsigned long int>(item.substr(dashPos + 1));
 
         ranges.emplace_back(first, second);
     }
 
+    AOC_PROFILE_COUNT("day2::readPuzzleInput", ranges.size());
     return ranges;
 }
 
 std::vector<unsigned long int> findInvalidIDs(unsigned long int start, unsigned long int end) {
+    AOC_PROFILE_SCOPE("day2::findInvalidIDs");
     assert(end > start);
 
     std::vector<unsigned long int> invalidIDs;
@@ -89,51 +95,202 @@ std::vector<unsigned long int> findInvalidIDs(unsigned long int start, unsigned
             invalidIDs.push_back(i);
         }
     }
+    AOC_PROFILE_COUNT("day2::findInvalidIDs", end - start + 1);
     return invalidIDs;
 }
 
-unsigned long int solvePuzzle(std::string inputfile) {
+unsigned __int128 powerOfTen(unsigned int exponent) {
+    unsigned __int128 result = 1;
+    for (unsigned int i = 0; i < exponent; i++) result = result * 10;
+    return result;
+}
+
+// Sum of the IDs in [start, end] with totalLength digits that are made of a block of
+// blockLength digits repeated. Those IDs are block * (10^(L-d) + ... + 10^d + 1), so the
+// valid blocks form a contiguous range and their sum is an arithmetic series.
+unsigned __int128 sumRepeatedBlockIDs(unsigned long int start, unsigned long int end,
+     unsigned int totalLength, unsigned int blockLength) {
+    assert(blockLength > 0 && totalLength % blockLength == 0);
+
+    unsigned __int128 multiplier = (powerOfTen(totalLength) - 1) / (powerOfTen(blockLength) - 1);
+    unsigned __int128 lo = std::max(powerOfTen(blockLength - 1), (start + multiplier - 1) / multiplier);
+    unsigned __int128 hi = std::min(powerOfTen(blockLength) - 1, end / multiplier);
+    if (lo > hi) return 0;
+
+    return multiplier * ((lo + hi) * (hi - lo + 1) / 2);
+}
+
+// Same result as summing findInvalidIDs(start, end), without visiting every ID
+unsigned long int sumInvalidIDs(unsigned long int start, unsigned long int end) {
+    AOC_PROFILE_SCOPE("day2::sumInvalidIDs");
+    unsigned __int128 result = 0;
+    // An unsigned long has at most 20 digits
+    for (unsigned int length = 2; length <= 20; length += 2) {
+        result = result + sumRepeatedBlockIDs(start, end, length, length / 2);
+    }
+    return result;
+}
+
+// IDs made of a block of digits repeated two or more times, e.g. 1111111 or 123123123
+std::vector<unsigned long int> findRepeatedPatternIDs(unsigned long int start, unsigned long int end) {
+    assert(end > start);
+
+    std::vector<unsigned long int> invalidIDs;
+    for (unsigned long int i = start; i <= end; i++) {
+        std::string istr = std::to_string(i);
+        for (std::size_t block = 1; block <= istr.size() / 2; block++) {
+            if (istr.size() % block != 0) continue;
+            bool repeated = true;
+            for (std::size_t j = block; j < istr.size() && repeated; j++) {
+                repeated = (istr[j] == istr[j - block]);
+            }
+            if (repeated) {
+                invalidIDs.push_back(i);
+                break;
+            }
+        }
+    }
+    return invalidIDs;
+}
+
+int mobius(unsigned int n) {
+    int result = 1;
+    for (unsigned int p = 2; p * p <= n; p++) {
+        if (n % p != 0) continue;
+        n = n / p;
+        if (n % p == 0) return 0;
+        result = -result;
+    }
+    return (n > 1) ? -result : result;
+}
+
+// Same result as summing findRepeatedPatternIDs(start, end), without visiting every ID.
+// An ID with L digits is repeated if its smallest period d is a proper divisor of L.
+// sumRepeatedBlockIDs(.., L, d) counts every ID whose period divides d, so an ID may be
+// counted for several d (111111 for d = 1, 2 and 3). Mobius inversion over the divisors
+// counts each ID exactly once: the repeated IDs sum to -sum_{d|L, d<L} mu(L/d) S(d).
+unsigned long int sumRepeatedPatternIDs(unsigned long int start, unsigned long int end) {
+    AOC_PROFILE_SCOPE("day2::sumRepeatedPatternIDs");
+    __int128 result = 0;
+    for (unsigned int length = 2; length <= 20; length++) {
+        for (unsigned int block = 1; block < length; block++) {
+            if (length % block != 0) continue;
+            int mu = mobius(length / block);
+            if (mu != 0) {
+                result = result - mu * static_cast<__int128>(sumRepeatedBlockIDs(start, end, length, block));
+            }
+        }
+    }
+    return static_cast<unsigned long int>(result);
+}
+
+unsigned long int solvePuzzle(std::string inputfile, PatternMode mode) {
+    AOC_PROFILE_SCOPE("day2::solvePuzzle");
     auto ranges = readPuzzleInput(inputfile);
     unsigned long int result = 0;
-    std::vector<unsigned long int> wrongIDs;
     for (auto r : ranges) {
-        wrongIDs = findInvalidIDs(r.first, r.second);
-        for (auto i : wrongIDs) {
-            result = result + i; 
+        if (mode == TWICE) {
+            result = result + sumInvalidIDs(r.first, r.second);
+        }
+        else {
+            result = result + sumRepeatedPatternIDs(r.first, r.second);
+        }
+    }
+    return result;
+}
+
+// Sum of the IDs in [start, end] made of one half repeated twice, checking every ID
+// arithmetically instead of building strings and vectors like findInvalidIDs
+unsigned long int sumInvalidIDsByScan(unsigned long int start, unsigned long int end) {
+    unsigned __int128 result = 0;
+    unsigned int digits = 1;
+    unsigned long int nextPower = 10;
+    for (unsigned long int i = start; ; i++) {
+        while (digits < 20 && i >= nextPower) {
+            digits++;
+            nextPower = (digits < 20) ? nextPower * 10 : nextPower;
+        }
+        if (digits % 2 == 0) {
+            unsigned long int half = static_cast<unsigned long int>(powerOfTen(digits / 2));
+            if (i / half == i % half) result = result + i;
+        }
+        if (i == end) break;
+    }
+    return result;
+}
+
+// Evaluate kernel over all ranges on a pool of threads. The IDs of all ranges, taken
+// one range after the other, are split into a few pieces per thread of at least
+// chunkSize IDs each, so a single wide range is shared between threads too. A piece
+// is located from its position in the sequence when it is evaluated, so the work
+// does not grow with the width of the ranges.
+unsigned long int sumRangesParallel(const std::vector<std::pair<unsigned long int, unsigned long int>>& ranges,
+     RangeKernel kernel, unsigned int threads, unsigned long int chunkSize) {
+    if (chunkSize == 0) throw std::invalid_argument("chunkSize must be at least 1");
+
+    // offsets[i] is the number of IDs in the ranges before range i
+    std::vector<unsigned __int128> offsets{0};
+    for (auto r : ranges) {
+        if (r.first > r.second) {
+            throw std::invalid_argument("Invalid range: " + std::to_string(r.first) + "-" + std::to_string(r.second));
+        }
+        offsets.push_back(offsets.back() + (r.second - r.first) + 1);
+    }
+    const unsigned __int128 total = offsets.back();
+    const std::size_t pieces = static_cast<std::size_t>(
+         std::min<unsigned __int128>(4 * std::max(1u, threads), (total + chunkSize - 1) / chunkSize));
+
+    return parallelSum(pieces, threads, [&](std::size_t p) {
+        unsigned __int128 begin = total * p / pieces;
+        const unsigned __int128 end = total * (p + 1) / pieces;
+        std::size_t i = std::upper_bound(offsets.begin(), offsets.end(), begin) - offsets.begin() - 1;
+        unsigned long int sum = 0;
+        for (; begin < end; i++) {
+            unsigned __int128 stop = std::min(end, offsets[i + 1]);
+            unsigned long int first = ranges[i].first + static_cast<unsigned long int>(begin - offsets[i]);
+            unsigned long int last = ranges[i].first + static_cast<unsigned long int>(stop - 1 - offsets[i]);
+            sum = sum + kernel(first, last);
+            begin = stop;
+        }
+        return sum;
+    });
+}
+
+unsigned long int solvePuzzleParallel(std::string inputfile, PatternMode mode,
+     unsigned int threads) {
+    auto ranges = readPuzzleInput(inputfile);
+    return sumRangesParallel(ranges, (mode == TWICE) ? sumInvalidIDs : sumRepeatedPatternIDs, threads);
+}
+
+void writeSnapshot(const std::string& inputfile, const std::string& snapshotfile) {
+    SourceStamp source = stampOf(inputfile, true);
+    std::vector<uint64_t> bounds;
+    for (auto r : readPuzzleInput(inputfile)) {
+        bounds.push_back(r.first);
+        bounds.push_back(r.second);
+    }
+    SnapshotWriter writer;
+    writer.add(std::span<const uint64_t>(bounds));
+    writer.write(snapshotfile, 2, source);
+}
+
+Snapshot openSnapshot(const std::string& inputfile, const std::string& snapshotfile, bool verify) {
+    return openSnapshotCache(inputfile, snapshotfile, 2, writeSnapshot, verify);
+}
+
+unsigned long int solveSnapshot(const Snapshot& snapshot, PatternMode mode) {
+    AOC_PROFILE_SCOPE("day2::solveSnapshot");
+    auto bounds = snapshot.section<uint64_t>(0);
+    unsigned long int result = 0;
+    for (std::size_t i = 0; i + 1 < bounds.size(); i += 2) {
+        if (mode == TWICE) {
+            result = result + sumInvalidIDs(bounds[i], bounds[i + 1]);
+        }
+        else {
+            result = result + sumRepeatedPatternIDs(bounds[i], bounds[i + 1]);
         }
-        wrongIDs.clear();
     }
     return result;
 }
 
-int main() {
-
-    // Tests for readPuzzleInput
-    auto ranges = readPuzzleInput("testinput_day2.txt");
-    assert(ranges.size() == 11);
-    assert(ranges[0].first == 11 && ranges[0].second == 22);
-    assert(ranges[1].first == 95 && ranges[1].second == 115);
-    assert(ranges[9].first == 824824821 && ranges[9].second == 824824827);
-    assert(ranges[10].first == 2121212118 && ranges[10].second == 2121212124);
-    std::cout << "All tests for readPuzzleInput pass" << std::endl;
-
-    // Tests for findInvalidIDs
-    assert((findInvalidIDs(11, 22) == std::vector<unsigned long int>{11,22}));
-    assert((findInvalidIDs(95, 115) == std::vector<unsigned long int>{99}));
-    assert((findInvalidIDs(998, 1012) == std::vector<unsigned long int>{1010}));
-    assert((findInvalidIDs(1188511880, 1188511890) == std::vector<unsigned long int>{1188511885}));
-    assert((findInvalidIDs(222220, 222224) == std::vector<unsigned long int>{222222}));
-    assert((findInvalidIDs(1698522, 1698528).size() == 0));
-    assert((findInvalidIDs(446443, 446449) == std::vector<unsigned long int>{446446}));
-    assert((findInvalidIDs(38593856, 38593862) == std::vector<unsigned long int>{38593859}));
-    std::cout << "All tests for findInvalidIDs pass" << std::endl;
-
-    assert(solvePuzzle("testinput_day2.txt") == 1227775554);
-    std::cout << "Test for solvePuzzle passes" << std::endl;
-
-    unsigned long int solution = solvePuzzle("input_day2.txt");
-    std::cout << "The solution is: " << solution << std::endl;
-
-    return 0;    
-
-}
\ No newline at end of file
+} // namespace day2
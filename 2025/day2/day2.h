@@ -0,0 +1,51 @@
+/* Day 2: Gift Shop
+https://adventofcode.com/2025/day/2
+*/
+
+#ifndef AOC_2025_DAY2_H
+#define AOC_2025_DAY2_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../common/parallel.h"
+#include "../common/snapshot.h"
+
+namespace day2 {
+
+std::vector<std::pair<unsigned long int, unsigned long int>> readPuzzleInput(std::string filename);
+
+std::vector<unsigned long int> findInvalidIDs(unsigned long int start, unsigned long int end);
+unsigned __int128 powerOfTen(unsigned int exponent);
+unsigned __int128 sumRepeatedBlockIDs(unsigned long int start, unsigned long int end,
+     unsigned int totalLength, unsigned int blockLength);
+unsigned long int sumInvalidIDs(unsigned long int start, unsigned long int end);
+
+std::vector<unsigned long int> findRepeatedPatternIDs(unsigned long int start, unsigned long int end);
+int mobius(unsigned int n);
+unsigned long int sumRepeatedPatternIDs(unsigned long int start, unsigned long int end);
+
+// TWICE: a block repeated exactly twice, REPEATED: a block repeated two or more times
+enum PatternMode {TWICE, REPEATED};
+
+unsigned long int solvePuzzle(std::string inputfile, PatternMode mode = TWICE);
+
+unsigned long int sumInvalidIDsByScan(unsigned long int start, unsigned long int end);
+
+using RangeKernel = unsigned long int (*)(unsigned long int start, unsigned long int end);
+
+unsigned long int sumRangesParallel(const std::vector<std::pair<unsigned long int, unsigned long int>>& ranges,
+     RangeKernel kernel, unsigned int threads = defaultThreadCount(), unsigned long int chunkSize = 1UL << 20);
+unsigned long int solvePuzzleParallel(std::string inputfile, PatternMode mode = TWICE,
+     unsigned int threads = defaultThreadCount());
+
+// Binary snapshot of the ranges (see common/snapshot.h), as pairs of uint64_t first, last
+void writeSnapshot(const std::string& inputfile, const std::string& snapshotfile);
+// Snapshot of inputfile at snapshotfile, written first when it is missing or stale
+Snapshot openSnapshot(const std::string& inputfile, const std::string& snapshotfile, bool verify = false);
+unsigned long int solveSnapshot(const Snapshot& snapshot, PatternMode mode = TWICE);
+
+} // namespace day2
+
+#endif
@@ -0,0 +1,27 @@
+/* Command line interface for Day 2
+
+Usage: day2 [input]
+
+Solves the puzzle for input (default input_day2.txt), for IDs repeated twice and
+for IDs repeated any number of times.
+*/
+
+#include <iostream>
+#include <string>
+
+#include "day2.h"
+
+using namespace day2;
+
+int main(int argc, char** argv) {
+
+    std::string inputfile = (argc >= 2) ? argv[1] : "input_day2.txt";
+
+    unsigned long int solution = solvePuzzle(inputfile);
+    std::cout << "The solution is: " << solution << std::endl;
+
+    unsigned long int repeated = solvePuzzle(inputfile, REPEATED);
+    std::cout << "The solution for any number of repeats is: " << repeated << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,120 @@
+/* Tests for Day 2, run from the day2 directory */
+
+#include <cstdio>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "day2.h"
+#include "../common/check.h"
+
+using namespace day2;
+
+int main() {
+
+    const std::string snapshotFile = scratchFile("snapshot_day2.tmp");
+
+    // Tests for readPuzzleInput
+    auto ranges = readPuzzleInput("testinput_day2.txt");
+    CHECK(ranges.size() == 11);
+    CHECK(ranges[0].first == 11 && ranges[0].second == 22);
+    CHECK(ranges[1].first == 95 && ranges[1].second == 115);
+    CHECK(ranges[9].first == 824824821 && ranges[9].second == 824824827);
+    CHECK(ranges[10].first == 2121212118 && ranges[10].second == 2121212124);
+    std::cout << "All tests for readPuzzleInput pass" << std::endl;
+
+    // Tests for findInvalidIDs
+    CHECK((findInvalidIDs(11, 22) == std::vector<unsigned long int>{11,22}));
+    CHECK((findInvalidIDs(95, 115) == std::vector<unsigned long int>{99}));
+    CHECK((findInvalidIDs(998, 1012) == std::vector<unsigned long int>{1010}));
+    CHECK((findInvalidIDs(1188511880, 1188511890) == std::vector<unsigned long int>{1188511885}));
+    CHECK((findInvalidIDs(222220, 222224) == std::vector<unsigned long int>{222222}));
+    CHECK((findInvalidIDs(1698522, 1698528).size() == 0));
+    CHECK((findInvalidIDs(446443, 446449) == std::vector<unsigned long int>{446446}));
+    CHECK((findInvalidIDs(38593856, 38593862) == std::vector<unsigned long int>{38593859}));
+    std::cout << "All tests for findInvalidIDs pass" << std::endl;
+
+    // Tests for sumInvalidIDs, using findInvalidIDs as reference
+    for (auto r : ranges) {
+        auto expected = findInvalidIDs(r.first, r.second);
+        CHECK(sumInvalidIDs(r.first, r.second) == std::accumulate(expected.begin(), expected.end(), 0UL));
+    }
+    for (unsigned long int start = 1; start < 1200; start += 7) {
+        for (unsigned long int end = start + 1; end < start + 1500; end += 97) {
+            auto expected = findInvalidIDs(start, end);
+            CHECK(sumInvalidIDs(start, end) == std::accumulate(expected.begin(), expected.end(), 0UL));
+        }
+    }
+    CHECK(sumInvalidIDs(1, 99) == 495);
+    CHECK(sumInvalidIDs(1000, 9999) == 495405);
+    CHECK(sumInvalidIDs(9999999999999999999UL, 10000000000999999999UL) == 0);
+    CHECK(sumInvalidIDs(10000000000000000000UL, 10000000001000000000UL) == 10000000001000000000UL);
+    std::cout << "All tests for sumInvalidIDs pass" << std::endl;
+
+    // Tests for sumRepeatedPatternIDs, using findRepeatedPatternIDs as reference
+    CHECK((findRepeatedPatternIDs(95, 115) == std::vector<unsigned long int>{99, 111}));
+    CHECK((findRepeatedPatternIDs(998, 1012) == std::vector<unsigned long int>{999, 1010}));
+    CHECK((findRepeatedPatternIDs(824824821, 824824827) == std::vector<unsigned long int>{824824824}));
+    CHECK((findRepeatedPatternIDs(2121212118, 2121212124) == std::vector<unsigned long int>{2121212121}));
+    CHECK(mobius(1) == 1 && mobius(2) == -1 && mobius(4) == 0 && mobius(6) == 1 && mobius(30) == -1);
+    for (auto r : ranges) {
+        auto expected = findRepeatedPatternIDs(r.first, r.second);
+        CHECK(sumRepeatedPatternIDs(r.first, r.second) == std::accumulate(expected.begin(), expected.end(), 0UL));
+    }
+    for (unsigned long int start = 1; start < 1200000; start += 99991) {
+        for (unsigned long int end = start + 1; end < start + 150000; end += 9973) {
+            auto expected = findRepeatedPatternIDs(start, end);
+            CHECK(sumRepeatedPatternIDs(start, end) == std::accumulate(expected.begin(), expected.end(), 0UL));
+        }
+    }
+    CHECK(sumRepeatedPatternIDs(111111, 111111 + 1) == 111111);
+    CHECK(sumRepeatedPatternIDs(1, 1000) == 495 + 111 * 45);
+    std::cout << "All tests for sumRepeatedPatternIDs pass" << std::endl;
+
+    CHECK(solvePuzzle("testinput_day2.txt") == 1227775554);
+    CHECK(solvePuzzle("testinput_day2.txt", REPEATED) == 4174379265);
+    std::cout << "Test for solvePuzzle passes" << std::endl;
+
+    // Tests for the parallel driver
+    CHECK(sumInvalidIDsByScan(11, 22) == 33);
+    CHECK(sumInvalidIDsByScan(1188511880, 1188511890) == 1188511885);
+    CHECK(sumInvalidIDsByScan(22, 22) == 22 && sumInvalidIDsByScan(23, 23) == 0);
+    CHECK(sumInvalidIDsByScan(18446744073709551610UL, 18446744073709551615UL) == 0);
+    for (unsigned int threads = 1; threads <= 4; threads++) {
+        for (unsigned long int chunkSize : {1UL, 7UL, 1000UL, 1UL << 40}) {
+            CHECK(sumRangesParallel(ranges, sumInvalidIDs, threads, chunkSize) == 1227775554);
+            CHECK(sumRangesParallel(ranges, sumRepeatedPatternIDs, threads, chunkSize) == 4174379265);
+        }
+        CHECK(sumRangesParallel(ranges, sumInvalidIDsByScan, threads, 5000) == 1227775554);
+        CHECK(solvePuzzleParallel("input_day2.txt", REPEATED, threads) == solvePuzzle("input_day2.txt", REPEATED));
+    }
+    CHECK(sumRangesParallel({{1, 18446744073709551615UL}}, sumInvalidIDs, 4, 1UL << 60) == sumInvalidIDs(1, 18446744073709551615UL));
+    // Huge ranges cost no more than narrow ones, whatever the chunk size
+    CHECK(sumRangesParallel({{1, 10000000000000UL}}, sumInvalidIDs, 1) == sumInvalidIDs(1, 10000000000000UL));
+    CHECK(sumRangesParallel({{0, 18446744073709551615UL}, {5, 1000000000000000UL}}, sumRepeatedPatternIDs, 3, 1) ==
+         sumRepeatedPatternIDs(0, 18446744073709551615UL) + sumRepeatedPatternIDs(5, 1000000000000000UL));
+    bool rejected = false;
+    try {
+        sumRangesParallel({{11, 22}, {100, 10}}, sumInvalidIDs, 2);
+    }
+    catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    CHECK(rejected);
+    CHECK(sumRangesParallel({}, sumInvalidIDs, 2) == 0);
+    std::cout << "All tests for sumRangesParallel pass" << std::endl;
+
+    // Check tests for snapshots pass
+    std::remove(snapshotFile.c_str());
+    for (auto file : {"testinput_day2.txt", "input_day2.txt"}) {
+        Snapshot snapshot = openSnapshot(file, snapshotFile);
+        CHECK(solveSnapshot(snapshot) == solvePuzzle(file));
+        CHECK(solveSnapshot(snapshot, REPEATED) == solvePuzzle(file, REPEATED));
+    }
+    std::remove(snapshotFile.c_str());
+    std::cout << "Tests for snapshots pass" << std::endl;
+
+    return 0;
+}
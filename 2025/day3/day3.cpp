@@ -30,34 +30,43 @@ The total output joltage is the sum of the maximum joltage from each bank, so in
 There are many batteries in front of you. Find the maximum joltage possible from each bank; what is the total output joltage?
 */
 
-#include <iostream>
-#include <fstream>
-#include <assert.h>
+#include "day3.h"
+
 #include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "../common/decode.h"
+#include "../common/input.h"
+#include "../common/profile.h"
+
+namespace day3 {
 
 std::vector<std::vector<unsigned int>> readPuzzleInput(std::string filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Failed to open file: " + filename);
-    }
+    AOC_PROFILE_SCOPE("day3::readPuzzleInput");
+    LineReader file(filename);
 
     std::vector<std::vector<unsigned int>> result;
     std::vector<unsigned int> bank;
-    std::string line;
-    while (std::getline(file, line)) {
+    std::string_view line;
+    while (file.next(line)) {
         if (line.empty()) continue;
         // Read bank
-        for (int i = 0; i < line.size(); i++) {
-            bank.push_back(std::stoi(line.substr(i,1)));
+        for (auto c : line) {
+            if (c < '0' || c > '9') {
+                throw std::runtime_error("Invalid digit in " + filename + ", line: " + std::string(line));
+            }
+            bank.push_back(c - '0');
         }
         // Save bank
         result.push_back(bank);
         bank.clear();
     }
+    AOC_PROFILE_COUNT("day3::readPuzzleInput", result.size());
     return result;
 }
 
-unsigned int getLargestJoltageInBank(std::vector<unsigned int> bank) {
+unsigned int getLargestJoltageInBank(const std::vector<unsigned int>& bank) {
     auto maxiter = std::max_element(bank.begin(), bank.end());
     auto maxindex = std::distance(bank.begin(), maxiter);
 
@@ -72,39 +81,138 @@ unsigned int getLargestJoltageInBank(std::vector<unsigned int> bank) {
     }
 }
 
+BankBuffer readBankBuffer(std::string filename) {
+    AOC_PROFILE_SCOPE("day3::readBankBuffer");
+    LineReader file(filename);
+
+    BankBuffer banks;
+    // One digit per byte of a mapped file is an upper bound, so the buffer is
+    // allocated once; streamed input grows it as needed
+    banks.digits.resize(file.contents().size());
+    std::size_t used = 0;
+    std::string_view line;
+    while (file.next(line)) {
+        if (line.empty()) continue;
+        if (used + line.size() > banks.digits.size()) {
+            banks.digits.resize(std::max(2 * banks.digits.size(), used + line.size()));
+        }
+        std::size_t valid = decodeDigits(line.data(), line.size(), banks.digits.data() + used);
+        if (valid != line.size()) {
+            throw std::runtime_error("Invalid digit in " + filename + " at column " + std::to_string(valid + 1) +
+                 ", line: " + std::string(line));
+        }
+        used = used + line.size();
+        banks.offsets.push_back(used);
+    }
+    banks.digits.resize(used);
+    AOC_PROFILE_COUNT("day3::readBankBuffer", banks.size());
+    return banks;
+}
+
+// Single pass: the best joltage ending at each digit pairs it with the largest digit before it
+unsigned int getLargestJoltageInBank(std::span<const uint8_t> bank) {
+    assert(bank.size() >= 2);
+    unsigned int largest = bank[0];
+    unsigned int best = 0;
+    for (std::size_t i = 1; i < bank.size(); i++) {
+        best = std::max(best, 10 * largest + bank[i]);
+        largest = std::max<unsigned int>(largest, bank[i]);
+    }
+    return best;
+}
+
+namespace {
+
+// Checks up front that k is at most 19, the digits that always fit in 64 bits, and
+// that every bank has at least k digits, since either would throw on a worker thread.
+// offsets are those of BankBuffer.
+template <typename Offsets>
+void checkBankLengths(const Offsets& offsets, std::size_t k) {
+    if (k > std::numeric_limits<unsigned long int>::digits10) {
+        throw std::invalid_argument("Joltages of " + std::to_string(k) + " digits do not fit in 64 bits");
+    }
+    for (std::size_t i = 0; i + 1 < offsets.size(); i++) {
+        if (offsets[i + 1] < offsets[i] + k) {
+            throw std::invalid_argument("Bank " + std::to_string(i + 1) + " has fewer than " + std::to_string(k) + " digits");
+        }
+    }
+}
+
+// Banks are handed out to parallelSum in blocks of 4096, so a task sums enough banks
+// to outweigh its scheduling and allocates its scratch once.
+// bank(i, scratch) returns the digits of bank i, and may decode them into scratch.
+template <typename Bank>
+unsigned long int sumBanks(std::size_t count, std::size_t k, unsigned int threads, Bank&& bank) {
+    const std::size_t blockSize = 4096;
+    std::size_t blocks = (count + blockSize - 1) / blockSize;
+
+    return parallelSum(blocks, threads, [&](std::size_t block) {
+        std::size_t end = std::min(count, (block + 1) * blockSize);
+        std::vector<uint8_t> scratch;
+        unsigned long int sum = 0;
+        for (std::size_t i = block * blockSize; i < end; i++) {
+            std::span<const uint8_t> digits = bank(i, scratch);
+            sum = sum + ((k == 2) ? getLargestJoltageInBank(digits) : getLargestJoltage(digits, k));
+        }
+        AOC_PROFILE_COUNT("day3::getLargestJoltageInBank", end - block * blockSize);
+        return sum;
+    });
+}
+
+}
+
+unsigned long int sumLargestJoltage(const BankBuffer& banks, std::size_t k, unsigned int threads) {
+    AOC_PROFILE_SCOPE("day3::sumLargestJoltage");
+    checkBankLengths(banks.offsets, k);
+    return sumBanks(banks.size(), k, threads, [&](std::size_t i, std::vector<uint8_t>&) {
+        return banks.bank(i);
+    });
+}
+
+unsigned long int solvePuzzle(std::string inputfile, std::size_t k) {
+    AOC_PROFILE_SCOPE("day3::solvePuzzle");
+    return sumLargestJoltage(readBankBuffer(inputfile), k);
+}
+
 unsigned int solvePuzzle(std::string inputfile) {
-    auto banks = readPuzzleInput(inputfile);
-    unsigned long int solution = 0;
-    for (auto b : banks) {
-        solution = solution + getLargestJoltageInBank(b);
+    AOC_PROFILE_SCOPE("day3::solvePuzzle");
+    return sumLargestJoltage(readBankBuffer(inputfile), 2);
+}
+
+void writeSnapshot(const std::string& inputfile, const std::string& snapshotfile) {
+    SourceStamp source = stampOf(inputfile, true);
+    BankBuffer banks = readBankBuffer(inputfile);
+    std::vector<uint64_t> offsets(banks.offsets.begin(), banks.offsets.end());
+    std::vector<uint8_t> nibbles((banks.digits.size() + 1) / 2, 0);
+    for (std::size_t i = 0; i < banks.digits.size(); i++) {
+        nibbles[i / 2] |= banks.digits[i] << (4 * (i % 2));
     }
-    return solution;
+    SnapshotWriter writer;
+    writer.add(std::span<const uint64_t>(offsets));
+    writer.add(std::span<const uint8_t>(nibbles));
+    writer.write(snapshotfile, 3, source);
+}
+
+Snapshot openSnapshot(const std::string& inputfile, const std::string& snapshotfile, bool verify) {
+    return openSnapshotCache(inputfile, snapshotfile, 3, writeSnapshot, verify);
+}
+
+unsigned long int solveSnapshot(const Snapshot& snapshot, std::size_t k, unsigned int threads) {
+    AOC_PROFILE_SCOPE("day3::solveSnapshot");
+    auto offsets = snapshot.section<uint64_t>(0);
+    auto nibbles = snapshot.section<uint8_t>(1);
+    // The payload is not checksummed by default, so check the offsets before indexing with them
+    if (offsets.empty() || offsets.back() > 2 * nibbles.size() || !std::is_sorted(offsets.begin(), offsets.end())) {
+        throw std::runtime_error("Invalid snapshot: inconsistent bank offsets");
+    }
+    checkBankLengths(offsets, k);
+    return sumBanks(offsets.size() - 1, k, threads, [&](std::size_t i, std::vector<uint8_t>& scratch) {
+        scratch.resize(offsets[i + 1] - offsets[i]);
+        for (std::size_t d = offsets[i]; d < offsets[i + 1]; d++) {
+            scratch[d - offsets[i]] = (nibbles[d / 2] >> (4 * (d % 2))) & 0xF;
+        }
+        return std::span<const uint8_t>(scratch);
+    });
 }
 
-int main(){
-
-    // Test readPuzzleInput
-    auto actual = readPuzzleInput("testinput_day3.txt");
-    assert(actual.size() == 4);
-    assert((actual[0] == std::vector<unsigned int>{9,8,7,6,5,4,3,2,1,1,1,1,1,1,1}));
-    assert((actual[1] == std::vector<unsigned int>{8,1,1,1,1,1,1,1,1,1,1,1,1,1,9}));
-    assert((actual[2] == std::vector<unsigned int>{2,3,4,2,3,4,2,3,4,2,3,4,2,7,8}));
-    assert((actual[3] == std::vector<unsigned int>{8,1,8,1,8,1,9,1,1,1,1,2,1,1,1}));
-    std::cout << "All tests for readPuzzleInput pass!" << std::endl;
-
-    // Test getLargestJoltageInBank
-    assert(getLargestJoltageInBank({9,8,7,6,5,4,3,2,1,1,1,1,1,1,1}) == 98);
-    assert(getLargestJoltageInBank({8,1,1,1,1,1,1,1,1,1,1,1,1,1,9}) == 89);
-    assert(getLargestJoltageInBank({2,3,4,2,3,4,2,3,4,2,3,4,2,7,8}) == 78);
-    assert(getLargestJoltageInBank({8,1,8,1,8,1,9,1,1,1,1,2,1,1,1}) == 92);
-    std::cout << "All tests for getLargestJoltageInBank pass!" << std::endl;
-
-    // Test for Solve Puzzle
-    assert(solvePuzzle("testinput_day3.txt") == 357);
-    std::cout << "The tests for solvePuzzle passes!" << std::endl;
-
-    unsigned long int solution = solvePuzzle("input_day3.txt");
-    std::cout << "The solution is: " << solution << std::endl;
-
-    return 0;
-}
\ No newline at end of file
+} // namespace day3
@@ -0,0 +1,103 @@
+/* Day 3: Lobby
+https://adventofcode.com/2025/day/3
+*/
+
+#ifndef AOC_2025_DAY3_H
+#define AOC_2025_DAY3_H
+
+#include <array>
+#include <assert.h>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../common/parallel.h"
+#include "../common/snapshot.h"
+
+namespace day3 {
+
+std::vector<std::vector<unsigned int>> readPuzzleInput(std::string filename);
+
+unsigned int getLargestJoltageInBank(const std::vector<unsigned int>& bank);
+
+// Largest number formed by choosing k digits of the bank in order. The chosen digits
+// are kept on a monotonic stack: a digit pops the smaller digits before it as long
+// as enough digits remain to fill the k positions. Runs in O(n) without allocating.
+// k is at most the number of digits that always fit in T, 19 for 64 bits.
+template <typename T = unsigned long int>
+T getLargestJoltage(std::span<const uint8_t> bank, std::size_t k) {
+    static_assert(std::numeric_limits<T>::is_specialized, "T must be an integer type with numeric_limits");
+    constexpr std::size_t maxDigits = std::numeric_limits<T>::digits10;
+    if (k > maxDigits) {
+        throw std::invalid_argument("Cannot fit " + std::to_string(k) + " digits in " +
+             std::to_string(std::numeric_limits<T>::digits) + " bits");
+    }
+    if (k > bank.size()) {
+        throw std::invalid_argument("Cannot choose " + std::to_string(k) + " digits from a bank of " +
+             std::to_string(bank.size()));
+    }
+
+    std::array<uint8_t, maxDigits> stack;
+    std::size_t size = 0;
+    std::size_t drops = bank.size() - k;
+    for (auto digit : bank) {
+        while (size > 0 && drops > 0 && stack[size - 1] < digit) {
+            size--;
+            drops--;
+        }
+        if (size < k) {
+            stack[size++] = digit;
+        }
+        else {
+            drops--;
+        }
+    }
+
+    T result = 0;
+    for (std::size_t i = 0; i < k; i++) {
+        result = 10 * result + stack[i];
+    }
+    return result;
+}
+
+// All banks of an input in one buffer of digits, without an allocation per bank.
+// The digits of bank i are digits[offsets[i]] up to digits[offsets[i + 1]].
+struct BankBuffer {
+    std::vector<uint8_t> digits;
+    std::vector<std::size_t> offsets{0};
+
+    std::size_t size() const {
+        return offsets.size() - 1;
+    }
+    std::span<const uint8_t> bank(std::size_t i) const {
+        return std::span<const uint8_t>(digits.data() + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+};
+
+BankBuffer readBankBuffer(std::string filename);
+
+unsigned int getLargestJoltageInBank(std::span<const uint8_t> bank);
+
+// Sum of the largest k digit joltages of all banks, computed on a pool of threads.
+// Throws std::invalid_argument if a bank has fewer than k digits, or k > 19.
+unsigned long int sumLargestJoltage(const BankBuffer& banks, std::size_t k,
+     unsigned int threads = defaultThreadCount());
+
+unsigned long int solvePuzzle(std::string inputfile, std::size_t k);
+unsigned int solvePuzzle(std::string inputfile);
+
+// Binary snapshot of the banks (see common/snapshot.h): the offsets of the banks as in
+// BankBuffer (uint64_t), and the digits packed two per byte, low nibble first
+void writeSnapshot(const std::string& inputfile, const std::string& snapshotfile);
+// Snapshot of inputfile at snapshotfile, written first when it is missing or stale
+Snapshot openSnapshot(const std::string& inputfile, const std::string& snapshotfile, bool verify = false);
+unsigned long int solveSnapshot(const Snapshot& snapshot, std::size_t k,
+     unsigned int threads = defaultThreadCount());
+
+} // namespace day3
+
+#endif
@@ -0,0 +1,27 @@
+/* Command line interface for Day 3
+
+Usage: day3 [input]
+
+Solves the puzzle for input (default input_day3.txt), turning on 2 and 12
+batteries per bank.
+*/
+
+#include <iostream>
+#include <string>
+
+#include "day3.h"
+
+using namespace day3;
+
+int main(int argc, char** argv) {
+
+    std::string inputfile = (argc >= 2) ? argv[1] : "input_day3.txt";
+
+    unsigned long int solution = solvePuzzle(inputfile);
+    std::cout << "The solution is: " << solution << std::endl;
+
+    unsigned long int solution12 = solvePuzzle(inputfile, 12);
+    std::cout << "The solution with 12 batteries is: " << solution12 << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,160 @@
+/* Tests for Day 3, run from the day3 directory */
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "day3.h"
+#include "../common/check.h"
+#include "../common/decode.h"
+
+using namespace day3;
+
+int main() {
+
+    const std::string shortFile = scratchFile("short_day3.tmp");
+    const std::string snapshotFile = scratchFile("snapshot_day3.tmp");
+
+    // Test readPuzzleInput
+    auto actual = readPuzzleInput("testinput_day3.txt");
+    CHECK(actual.size() == 4);
+    CHECK((actual[0] == std::vector<unsigned int>{9,8,7,6,5,4,3,2,1,1,1,1,1,1,1}));
+    CHECK((actual[1] == std::vector<unsigned int>{8,1,1,1,1,1,1,1,1,1,1,1,1,1,9}));
+    CHECK((actual[2] == std::vector<unsigned int>{2,3,4,2,3,4,2,3,4,2,3,4,2,7,8}));
+    CHECK((actual[3] == std::vector<unsigned int>{8,1,8,1,8,1,9,1,1,1,1,2,1,1,1}));
+    std::cout << "All tests for readPuzzleInput pass!" << std::endl;
+
+    // Test getLargestJoltageInBank
+    CHECK(getLargestJoltageInBank({9,8,7,6,5,4,3,2,1,1,1,1,1,1,1}) == 98);
+    CHECK(getLargestJoltageInBank({8,1,1,1,1,1,1,1,1,1,1,1,1,1,9}) == 89);
+    CHECK(getLargestJoltageInBank({2,3,4,2,3,4,2,3,4,2,3,4,2,7,8}) == 78);
+    CHECK(getLargestJoltageInBank({8,1,8,1,8,1,9,1,1,1,1,2,1,1,1}) == 92);
+    std::cout << "All tests for getLargestJoltageInBank pass!" << std::endl;
+
+    // Test getLargestJoltage
+    std::vector<uint8_t> bank = {9,8,7,6,5,4,3,2,1,1,1,1,1,1,1};
+    CHECK(getLargestJoltage(bank, 2) == 98);
+    CHECK(getLargestJoltage(bank, 12) == 987654321111UL);
+    CHECK(getLargestJoltage(bank, 15) == 987654321111111UL);
+    CHECK(getLargestJoltage(bank, 0) == 0);
+    bank = {8,1,1,1,1,1,1,1,1,1,1,1,1,1,9};
+    CHECK(getLargestJoltage(bank, 12) == 811111111119UL);
+    bank = {2,3,4,2,3,4,2,3,4,2,3,4,2,7,8};
+    CHECK(getLargestJoltage(bank, 12) == 434234234278UL);
+    bank = {8,1,8,1,8,1,9,1,1,1,1,2,1,1,1};
+    CHECK(getLargestJoltage(bank, 12) == 888911112111UL);
+    bank.assign(30, 9);
+    CHECK(getLargestJoltage<unsigned __int128>(bank, 30) == (unsigned __int128)999999999999999UL * 1000000000000000UL + 999999999999999UL);
+    for (auto& b : actual) {
+        std::vector<uint8_t> digits(b.begin(), b.end());
+        CHECK(getLargestJoltage(digits, 2) == getLargestJoltageInBank(b));
+    }
+    // Too few digits, or more than fit in 128 bits, throw instead of reading past the stack
+    auto throwsInvalid = [](auto&& f) {
+        try {
+            f();
+        }
+        catch (const std::invalid_argument&) {
+            return true;
+        }
+        return false;
+    };
+    CHECK(throwsInvalid([&] { return getLargestJoltage(bank, 31); }));
+    bank.assign(40, 9);
+    // 20 digits may overflow 64 bits, while 19 always fit
+    CHECK(getLargestJoltage(bank, 19) == 9999999999999999999UL);
+    CHECK(throwsInvalid([&] { return getLargestJoltage(bank, 20); }));
+    CHECK(getLargestJoltage<unsigned __int128>(bank, 20) == (unsigned __int128)9999999999999999999UL * 10 + 9);
+    CHECK(throwsInvalid([&] { return getLargestJoltage<unsigned __int128>(bank, 39); }));
+    BankBuffer short_banks;
+    short_banks.digits = {9, 8, 7, 6, 5, 4, 3, 2, 1, 1, 1, 1, 5, 6};
+    short_banks.offsets = {0, 12, 14};
+    CHECK(throwsInvalid([&] { return sumLargestJoltage(short_banks, 12, 2); }));
+    CHECK(sumLargestJoltage(short_banks, 2, 2) == 98 + 56);
+    CHECK(throwsInvalid([&] { return sumLargestJoltage(short_banks, 20, 1); }));
+    {
+        std::ofstream short_file(shortFile);
+        short_file << "987654321111\n56\n";
+    }
+    CHECK(throwsInvalid([&] { return solvePuzzle(shortFile, 12); }));
+    std::remove(shortFile.c_str());
+    std::cout << "All tests for getLargestJoltage pass!" << std::endl;
+
+    // Test readBankBuffer and the solvers on views into it
+    auto buffer = readBankBuffer("testinput_day3.txt");
+    CHECK(buffer.size() == 4 && buffer.digits.size() == 60);
+    for (std::size_t i = 0; i < buffer.size(); i++) {
+        CHECK(std::vector<unsigned int>(buffer.bank(i).begin(), buffer.bank(i).end()) == actual[i]);
+        CHECK(getLargestJoltageInBank(buffer.bank(i)) == getLargestJoltageInBank(actual[i]));
+    }
+    bank = {1,9};
+    CHECK(getLargestJoltageInBank(std::span<const uint8_t>(bank)) == 19);
+    bank = {9,1,9};
+    CHECK(getLargestJoltageInBank(std::span<const uint8_t>(bank)) == 99);
+    for (unsigned int threads = 1; threads <= 4; threads++) {
+        CHECK(sumLargestJoltage(buffer, 2, threads) == 357);
+        CHECK(sumLargestJoltage(buffer, 12, threads) == 3121910778619UL);
+    }
+    CHECK(sumLargestJoltage(BankBuffer(), 12) == 0);
+    std::cout << "All tests for BankBuffer pass!" << std::endl;
+
+    // Test the digit decoders, on runs longer than one AVX2 step
+    std::string text = "0123456789876543210123456789876543210123456789";
+    std::vector<DigitDecoder> decoders = {decodeDigitsScalar, selectDigitDecoder()};
+    for (auto decoder : decoders) {
+        std::vector<uint8_t> digits(text.size());
+        CHECK(decoder(text.data(), text.size(), digits.data()) == text.size());
+        for (std::size_t i = 0; i < text.size(); i++) CHECK(digits[i] == text[i] - '0');
+        for (std::size_t bad : {0, 5, 31, 32, 40, 45}) {
+            for (char c : {'/', ':', 'a', '\0', '\xff'}) {
+                std::string invalid = text;
+                invalid[bad] = c;
+                CHECK(decoder(invalid.data(), invalid.size(), digits.data()) == bad);
+            }
+        }
+        CHECK(decoder(text.data(), 0, digits.data()) == 0);
+    }
+    std::cout << "All tests for decodeDigits pass!" << std::endl;
+
+    // Test for Solve Puzzle
+    CHECK(solvePuzzle("testinput_day3.txt") == 357);
+    CHECK(solvePuzzle("testinput_day3.txt", 2) == 357);
+    CHECK(solvePuzzle("testinput_day3.txt", 12) == 3121910778619UL);
+    std::cout << "The tests for solvePuzzle passes!" << std::endl;
+
+    // Check tests for snapshots pass
+    std::remove(snapshotFile.c_str());
+    for (auto file : {"testinput_day3.txt", "input_day3.txt"}) {
+        Snapshot snapshot = openSnapshot(file, snapshotFile);
+        CHECK(solveSnapshot(snapshot, 2) == solvePuzzle(file));
+        for (unsigned int threads = 1; threads <= 3; threads++) {
+            CHECK(solveSnapshot(snapshot, 12, threads) == solvePuzzle(file, 12));
+        }
+    }
+    {
+        // Offsets that are out of order are rejected before they are used, even though
+        // the payload checksum is not checked by default
+        std::FILE* file = std::fopen(snapshotFile.c_str(), "r+b");
+        std::fseek(file, SnapshotWriter::payloadStart(2) + sizeof(uint64_t), SEEK_SET);
+        for (int i = 0; i < 8; i++) std::fputc(0xFF, file);
+        std::fclose(file);
+        Snapshot damaged(snapshotFile, 3);
+        bool rejected = false;
+        try {
+            solveSnapshot(damaged, 2);
+        }
+        catch (const std::runtime_error&) {
+            rejected = true;
+        }
+        CHECK(rejected);
+    }
+    std::remove(snapshotFile.c_str());
+    std::cout << "Tests for snapshots pass" << std::endl;
+
+    return 0;
+}
@@ -41,21 +41,28 @@ Consider your complete diagram of the paper roll locations. How many rolls of pa
 
 */
 
-#include <fstream>
-#include <iostream>
+#include "day4.h"
+
 #include <assert.h>
-#include <iterator>
-#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#include "../common/decode.h"
+#include "../common/input.h"
+#include "../common/profile.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace day4 {
 
 std::vector<std::vector<unsigned int>> readPuzzleInput(std::string filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Failed to open file: " + filename);
-    }
+    AOC_PROFILE_SCOPE("day4::readPuzzleInput");
+    LineReader file(filename);
     std::vector<std::vector<unsigned int>> result;
     std::vector<unsigned int> l;
-    std::string line;
-    while (std::getline(file, line)) {
+    std::string_view line;
+    while (file.next(line)) {
         l.push_back(0); // padding for easy processing
         for (auto c : line) {
             unsigned int x = (c == '.') ? 0 : 1;
@@ -71,6 +78,7 @@ std::vector<std::vector<unsigned int>> readPuzzleInput(std::string filename) {
     i = result.insert(i, padding);
     result.push_back(padding);
 
+    AOC_PROFILE_COUNT("day4::readPuzzleInput", (result.size() - 2) * (result[0].size() - 2));
     return result;
 }
 
@@ -89,48 +97,402 @@ unsigned int countAccessibleRolls(std::vector<unsigned int>& top,
 }
 
 unsigned int solvePuzzle(std::string inputfile) {
+    AOC_PROFILE_SCOPE("day4::solvePuzzle");
     auto grid = readPuzzleInput(inputfile);
 
     unsigned int solution = 0;
     for (int i = 1; i < grid.size() - 1; i++) {
         solution = solution + countAccessibleRolls(grid[i-1], grid[i], grid[i+1]);
     }
+    AOC_PROFILE_COUNT("day4::countAccessibleRolls", grid.size() - 2);
     return solution;
 }
 
+// Pack a grid as returned by readPuzzleInput (with its padding) into one bit per cell
+PackedGrid packGrid(const std::vector<std::vector<unsigned int>>& grid) {
+    assert(grid.size() >= 2 && grid[0].size() >= 2);
 
-int main() {
+    PackedGrid packed;
+    packed.rows = grid.size() - 2;
+    packed.cols = grid[0].size() - 2;
+    packed.wordsPerRow = (packed.cols + 63) / 64;
+    packed.bits.assign((packed.rows + 2) * packed.wordsPerRow, 0);
+    for (std::size_t r = 0; r < packed.rows; r++) {
+        uint64_t* words = packed.row(r + 1);
+        for (std::size_t c = 0; c < packed.cols; c++) {
+            if (grid[r + 1][c + 1]) words[c / 64] |= uint64_t(1) << (c % 64);
+        }
+    }
+    return packed;
+}
 
-    // Test readPuzzleInput
-    auto actual = readPuzzleInput("testinput_day4.txt");
-    assert(actual.size() == 12);
-    assert((actual[1] == std::vector<unsigned int>{0,0,0,1,1,0,1,1,1,1,0,0}));
-    assert((actual[2] == std::vector<unsigned int>{0,1,1,1,0,1,0,1,0,1,1,0}));
-    assert((actual[3] == std::vector<unsigned int>{0,1,1,1,1,1,0,1,0,1,1,0}));
-    assert((actual[4] == std::vector<unsigned int>{0,1,0,1,1,1,1,0,0,1,0,0}));
-    assert((actual[5] == std::vector<unsigned int>{0,1,1,0,1,1,1,1,0,1,1,0}));
-    assert((actual[6] == std::vector<unsigned int>{0,0,1,1,1,1,1,1,1,0,1,0}));
-    assert((actual[7] == std::vector<unsigned int>{0,0,1,0,1,0,1,0,1,1,1,0}));
-    assert((actual[8] == std::vector<unsigned int>{0,1,0,1,1,1,0,1,1,1,1,0}));
-    assert((actual[9] == std::vector<unsigned int>{0,0,1,1,1,1,1,1,1,1,0,0}));
-    assert((actual[10] == std::vector<unsigned int>{0,1,0,1,0,1,1,1,0,1,0,0}));
-    std::cout << "All tests for readPuzzleInput pass!" << std::endl;
-    
-    // Tests countAccessibleRolls
-    assert(countAccessibleRolls(actual[0], actual[1], actual[2]) == 5);
-    assert(countAccessibleRolls(actual[1], actual[2], actual[3]) == 1);
-    assert(countAccessibleRolls(actual[2], actual[3], actual[4]) == 1);
-    assert(countAccessibleRolls(actual[3], actual[4], actual[5]) == 0);
-    assert(countAccessibleRolls(actual[4], actual[5], actual[6]) == 2);
-    assert(countAccessibleRolls(actual[5], actual[6], actual[7]) == 0);
-    assert(countAccessibleRolls(actual[6], actual[7], actual[8]) == 0);
-    assert(countAccessibleRolls(actual[7], actual[8], actual[9]) == 1);
-    assert(countAccessibleRolls(actual[8], actual[9], actual[10]) == 0);
-    assert(countAccessibleRolls(actual[9], actual[10], actual[11]) == 3);
-    std::cout << "All tests for countAccessibleRolls pass!" << std::endl;
-
-    unsigned long int solution = solvePuzzle("input_day4.txt");
-    std::cout << "The solution is: " << solution << std::endl;
-
-    return 0;
-}
\ No newline at end of file
+PackedGrid readPackedPuzzleInput(std::string filename) {
+    AOC_PROFILE_SCOPE("day4::readPackedPuzzleInput");
+    LineReader file(filename);
+    PackedGrid packed;
+    std::string_view line;
+    while (file.next(line)) {
+        if (line.empty()) continue;
+        if (packed.rows == 0) {
+            packed.cols = line.size();
+            packed.wordsPerRow = (packed.cols + 63) / 64;
+            packed.bits.assign(packed.wordsPerRow, 0); // padding row
+        }
+        if (line.size() != packed.cols) {
+            throw std::runtime_error("Inconsistent row length in " + filename + ", line: " + std::string(line));
+        }
+        packed.bits.resize(packed.bits.size() + packed.wordsPerRow);
+        std::size_t valid = decodeRolls(line.data(), line.size(), packed.row(packed.rows + 1));
+        if (valid != line.size()) {
+            throw std::runtime_error("Invalid cell in " + filename + " at column " + std::to_string(valid + 1) +
+                 ", line: " + std::string(line));
+        }
+        packed.rows++;
+    }
+    packed.bits.resize(packed.bits.size() + packed.wordsPerRow, 0); // padding row
+    AOC_PROFILE_COUNT("day4::readPackedPuzzleInput", packed.rows * packed.cols);
+    return packed;
+}
+
+// Mask of the cells in 64 consecutive columns that have at most one of the four
+// "weight two" carries set, i.e. fewer than four of the eight neighbours set.
+// The neighbours are added with bit-sliced full adders, so all 64 lanes are
+// counted with a handful of word operations.
+uint64_t fewerThanFourNeighbours(uint64_t n0, uint64_t n1, uint64_t n2, uint64_t n3,
+     uint64_t n4, uint64_t n5, uint64_t n6, uint64_t n7) {
+    // Full adders: (n0,n1,n2) and (n3,n4,n5), half adder: (n6,n7)
+    uint64_t sumA = n0 ^ n1 ^ n2;
+    uint64_t carryA = (n0 & n1) | (n2 & (n0 ^ n1));
+    uint64_t sumB = n3 ^ n4 ^ n5;
+    uint64_t carryB = (n3 & n4) | (n5 & (n3 ^ n4));
+    uint64_t sumC = n6 ^ n7;
+    uint64_t carryC = n6 & n7;
+    // The ones bit of the total is sumA ^ sumB ^ sumC, only its carry matters
+    uint64_t carryD = (sumA & sumB) | (sumC & (sumA ^ sumB));
+    // total = ones + 2 * (carryA + carryB + carryC + carryD), so total < 4 iff at most one carry is set
+    uint64_t atLeastTwo = (carryA & carryB) | (carryC & carryD) | ((carryA | carryB) & (carryC | carryD));
+    return ~atLeastTwo;
+}
+
+unsigned long int countAccessibleRollsPacked(const PackedGridView& grid) {
+    return countAccessibleRollsPacked(grid, 0, grid.rows, 0, grid.wordsPerRow);
+}
+
+unsigned long int countAccessibleRollsPacked(const PackedGridView& grid, std::size_t rowBegin, std::size_t rowEnd,
+     std::size_t wordBegin, std::size_t wordEnd) {
+    assert(rowEnd <= grid.rows && wordEnd <= grid.wordsPerRow);
+    const std::size_t n = grid.wordsPerRow;
+    // Words holding the west (c-1) and east (c+1) neighbour of every column in word w
+    auto west = [](const uint64_t* words, std::size_t w) {
+        return (words[w] << 1) | (w > 0 ? words[w - 1] >> 63 : 0);
+    };
+    auto east = [n](const uint64_t* words, std::size_t w) {
+        return (words[w] >> 1) | (w + 1 < n ? words[w + 1] << 63 : 0);
+    };
+
+    unsigned long int result = 0;
+    for (std::size_t r = rowBegin + 1; r <= rowEnd; r++) {
+        const uint64_t* top = grid.row(r - 1);
+        const uint64_t* row = grid.row(r);
+        const uint64_t* bottom = grid.row(r + 1);
+        for (std::size_t w = wordBegin; w < wordEnd; w++) {
+            uint64_t accessible = row[w] & fewerThanFourNeighbours(
+                west(top, w), top[w], east(top, w),
+                west(row, w), east(row, w),
+                west(bottom, w), bottom[w], east(bottom, w));
+            result = result + __builtin_popcountll(accessible);
+        }
+    }
+    return result;
+}
+
+// Padded grid with one byte per cell, from a grid as returned by readPuzzleInput
+std::vector<std::vector<uint8_t>> toByteGrid(const std::vector<std::vector<unsigned int>>& grid) {
+    std::vector<std::vector<uint8_t>> result;
+    for (auto& row : grid) {
+        result.emplace_back(row.begin(), row.end());
+    }
+    return result;
+}
+
+unsigned int countAccessibleRollsScalar(const uint8_t* top, const uint8_t* row, const uint8_t* bottom, std::size_t size) {
+    unsigned int result = 0;
+    for (std::size_t i = 1; i + 1 < size; i++) {
+        if (row[i]) {
+            int nr = row[i-1] + row[i+1] + top[i-1] + top[i] + top[i+1] + bottom[i-1] + bottom[i] + bottom[i+1];
+            if (nr < 4) result++;
+        }
+    }
+    return result;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// The eight neighbours are added in 8-bit lanes (at most 8, no overflow), then the
+// "occupied and fewer than four" test is reduced to a bitmask and counted
+__attribute__((target("sse2")))
+unsigned int countAccessibleRollsSSE2(const uint8_t* top, const uint8_t* row, const uint8_t* bottom, std::size_t size) {
+    auto load = [](const uint8_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); };
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i four = _mm_set1_epi8(4);
+
+    unsigned int result = 0;
+    std::size_t i = 1;
+    for (; i + 16 < size; i += 16) {
+        __m128i sum = _mm_add_epi8(load(top + i - 1), load(top + i));
+        sum = _mm_add_epi8(sum, load(top + i + 1));
+        sum = _mm_add_epi8(sum, load(row + i - 1));
+        sum = _mm_add_epi8(sum, load(row + i + 1));
+        sum = _mm_add_epi8(sum, load(bottom + i - 1));
+        sum = _mm_add_epi8(sum, load(bottom + i));
+        sum = _mm_add_epi8(sum, load(bottom + i + 1));
+        __m128i occupied = _mm_cmpgt_epi8(load(row + i), zero);
+        __m128i accessible = _mm_and_si128(occupied, _mm_cmpgt_epi8(four, sum));
+        result = result + __builtin_popcount(_mm_movemask_epi8(accessible));
+    }
+    return result + countAccessibleRollsScalar(top + i - 1, row + i - 1, bottom + i - 1, size - i + 1);
+}
+
+__attribute__((target("avx2")))
+unsigned int countAccessibleRollsAVX2(const uint8_t* top, const uint8_t* row, const uint8_t* bottom, std::size_t size) {
+#define LOAD_ROW(p) _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p))
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i four = _mm256_set1_epi8(4);
+
+    unsigned int result = 0;
+    std::size_t i = 1;
+    for (; i + 32 < size; i += 32) {
+        __m256i sum = _mm256_add_epi8(LOAD_ROW(top + i - 1), LOAD_ROW(top + i));
+        sum = _mm256_add_epi8(sum, LOAD_ROW(top + i + 1));
+        sum = _mm256_add_epi8(sum, LOAD_ROW(row + i - 1));
+        sum = _mm256_add_epi8(sum, LOAD_ROW(row + i + 1));
+        sum = _mm256_add_epi8(sum, LOAD_ROW(bottom + i - 1));
+        sum = _mm256_add_epi8(sum, LOAD_ROW(bottom + i));
+        sum = _mm256_add_epi8(sum, LOAD_ROW(bottom + i + 1));
+        __m256i occupied = _mm256_cmpgt_epi8(LOAD_ROW(row + i), zero);
+        __m256i accessible = _mm256_and_si256(occupied, _mm256_cmpgt_epi8(four, sum));
+        result = result + __builtin_popcount(static_cast<unsigned int>(_mm256_movemask_epi8(accessible)));
+    }
+#undef LOAD_ROW
+    return result + countAccessibleRollsScalar(top + i - 1, row + i - 1, bottom + i - 1, size - i + 1);
+}
+#endif
+
+// Pick the widest kernel the CPU supports
+RowKernel selectRowKernel() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return countAccessibleRollsAVX2;
+    if (__builtin_cpu_supports("sse2")) return countAccessibleRollsSSE2;
+#endif
+    return countAccessibleRollsScalar;
+}
+
+unsigned int countAccessibleRolls(const std::vector<uint8_t>& top,
+     const std::vector<uint8_t>& row, const std::vector<uint8_t>& bottom) {
+    assert(row.size() == top.size() && row.size() == bottom.size());
+    static const RowKernel kernel = selectRowKernel();
+    return kernel(top.data(), row.data(), bottom.data(), row.size());
+}
+
+unsigned long int countAccessibleRollsTiled(const PackedGridView& grid, SweepGeometry geometry, unsigned int threads) {
+    return sweepTiles(grid.rows, grid.cols, geometry, threads, 64,
+         [&](std::size_t rowBegin, std::size_t rowEnd, std::size_t colBegin, std::size_t colEnd) {
+        return countAccessibleRollsPacked(grid, rowBegin, rowEnd, colBegin / 64, (colEnd + 63) / 64);
+    });
+}
+
+unsigned long int countAccessibleRollsTiled(const std::vector<std::vector<uint8_t>>& grid,
+     SweepGeometry geometry, unsigned int threads) {
+    assert(grid.size() >= 2 && grid[0].size() >= 2);
+    static const RowKernel kernel = selectRowKernel();
+    return sweepTiles(grid.size() - 2, grid[0].size() - 2, geometry, threads, 1,
+         [&](std::size_t rowBegin, std::size_t rowEnd, std::size_t colBegin, std::size_t colEnd) {
+        // The kernel counts the cells between the first and last byte it is given,
+        // so the tile is passed with the padding or tile column on either side
+        unsigned long int result = 0;
+        for (std::size_t r = rowBegin + 1; r <= rowEnd; r++) {
+            result = result + kernel(grid[r - 1].data() + colBegin, grid[r].data() + colBegin,
+                 grid[r + 1].data() + colBegin, colEnd - colBegin + 2);
+        }
+        return result;
+    });
+}
+
+unsigned long int solvePuzzleTiled(std::string inputfile, SweepGeometry geometry, unsigned int threads) {
+    AOC_PROFILE_SCOPE("day4::solvePuzzleTiled");
+    return countAccessibleRollsTiled(readPackedPuzzleInput(inputfile), geometry, threads);
+}
+
+// Repeatedly remove every accessible roll until none is left, rescanning the
+// whole grid in each round. Used as the reference for removeAccessibleRolls.
+RemovalResult removeAccessibleRollsByRescan(std::vector<std::vector<unsigned int>> grid) {
+    RemovalResult result;
+    std::vector<std::pair<std::size_t, std::size_t>> accessible;
+    while (true) {
+        for (std::size_t r = 1; r < grid.size() - 1; r++) {
+            for (std::size_t c = 1; c < grid[r].size() - 1; c++) {
+                if (!grid[r][c]) continue;
+                unsigned int nr = grid[r-1][c-1] + grid[r-1][c] + grid[r-1][c+1] + grid[r][c-1]
+                    + grid[r][c+1] + grid[r+1][c-1] + grid[r+1][c] + grid[r+1][c+1];
+                if (nr < 4) accessible.emplace_back(r, c);
+            }
+        }
+        if (accessible.empty()) break;
+        for (auto [r, c] : accessible) grid[r][c] = 0;
+        result.removed = result.removed + accessible.size();
+        result.rounds++;
+        accessible.clear();
+    }
+    return result;
+}
+
+// Same result as removeAccessibleRollsByRescan, but every cell is visited a constant
+// number of times: the neighbour counts are kept up to date as rolls are removed,
+// and a roll is queued for the next round when its count drops from 4 to 3.
+namespace {
+
+// Worklist removal on a flat padded grid, present[r * width + c] for padded row r and column c
+RemovalResult removeAccessibleRolls(std::size_t width, std::size_t height, std::vector<uint8_t> present) {
+    const std::ptrdiff_t offsets[8] = {
+        -std::ptrdiff_t(width) - 1, -std::ptrdiff_t(width), -std::ptrdiff_t(width) + 1, -1,
+        1, std::ptrdiff_t(width) - 1, std::ptrdiff_t(width), std::ptrdiff_t(width) + 1};
+
+    // Number of neighbouring rolls of each cell
+    std::vector<uint8_t> counts(width * height, 0);
+
+    std::vector<std::size_t> current;
+    std::vector<std::size_t> next;
+    for (std::size_t r = 1; r < height - 1; r++) {
+        for (std::size_t c = 1; c < width - 1; c++) {
+            std::size_t cell = r * width + c;
+            for (auto offset : offsets) counts[cell] += present[cell + offset];
+            if (present[cell] && counts[cell] < 4) current.push_back(cell);
+        }
+    }
+
+    RemovalResult result;
+    while (!current.empty()) {
+        for (auto cell : current) present[cell] = 0;
+        for (auto cell : current) {
+            for (auto offset : offsets) {
+                std::size_t neighbour = cell + offset;
+                // Only a roll that had exactly 4 neighbours becomes accessible here,
+                // rolls with fewer are already queued in this round
+                if (present[neighbour] && --counts[neighbour] == 3) next.push_back(neighbour);
+            }
+        }
+        result.removed = result.removed + current.size();
+        result.rounds++;
+        current.swap(next);
+        next.clear();
+    }
+    return result;
+}
+
+}
+
+RemovalResult removeAccessibleRolls(const std::vector<std::vector<unsigned int>>& grid) {
+    assert(grid.size() >= 2 && grid[0].size() >= 2);
+    const std::size_t width = grid[0].size();
+    const std::size_t height = grid.size();
+    std::vector<uint8_t> present(width * height, 0);
+    for (std::size_t r = 0; r < height; r++) {
+        for (std::size_t c = 0; c < width; c++) present[r * width + c] = grid[r][c] ? 1 : 0;
+    }
+    return removeAccessibleRolls(width, height, std::move(present));
+}
+
+RemovalResult removeAccessibleRolls(const PackedGridView& grid) {
+    const std::size_t width = grid.cols + 2;
+    const std::size_t height = grid.rows + 2;
+    std::vector<uint8_t> present(width * height, 0);
+    for (std::size_t r = 1; r <= grid.rows; r++) {
+        const uint64_t* words = grid.row(r);
+        for (std::size_t c = 0; c < grid.cols; c++) present[r * width + c + 1] = (words[c / 64] >> (c % 64)) & 1;
+    }
+    return removeAccessibleRolls(width, height, std::move(present));
+}
+
+void writeSnapshot(const std::string& inputfile, const std::string& snapshotfile) {
+    SourceStamp source = stampOf(inputfile, true);
+    PackedGrid grid = readPackedPuzzleInput(inputfile);
+    const uint64_t shape[3] = {grid.rows, grid.cols, grid.wordsPerRow};
+    SnapshotWriter writer;
+    writer.add(std::span<const uint64_t>(shape));
+    writer.add(std::span<const uint64_t>(grid.bits));
+    writer.write(snapshotfile, 4, source);
+}
+
+Snapshot openSnapshot(const std::string& inputfile, const std::string& snapshotfile, bool verify) {
+    return openSnapshotCache(inputfile, snapshotfile, 4, writeSnapshot, verify);
+}
+
+PackedGridView snapshotGrid(const Snapshot& snapshot) {
+    auto shape = snapshot.section<uint64_t>(0);
+    auto bits = snapshot.section<uint64_t>(1);
+    // The payload is not checksummed by default, so the shape is checked against the
+    // bits it covers without overflowing
+    if (shape.size() != 3 || shape[1] > 64 * bits.size() || shape[2] != (shape[1] + 63) / 64 ||
+         (shape[2] == 0 ? !bits.empty() : (bits.size() % shape[2] != 0 || shape[0] > bits.size() ||
+         bits.size() / shape[2] != shape[0] + 2))) {
+        throw std::runtime_error("Invalid snapshot: inconsistent grid shape");
+    }
+    return {shape[0], shape[1], shape[2], bits.data()};
+}
+
+unsigned long int solveSnapshot(const Snapshot& snapshot, unsigned int threads) {
+    AOC_PROFILE_SCOPE("day4::solveSnapshot");
+    return countAccessibleRollsTiled(snapshotGrid(snapshot), SweepGeometry(), threads);
+}
+
+FloorMap::FloorMap(const std::vector<std::vector<unsigned int>>& grid) {
+    assert(grid.size() >= 2 && grid[0].size() >= 2);
+    width = grid[0].size();
+    height = grid.size();
+    present.assign(width * height, 0);
+    counts.assign(width * height, 0);
+    for (std::size_t r = 1; r < height - 1; r++) {
+        for (std::size_t c = 1; c < width - 1; c++) {
+            if (grid[r][c]) set(r - 1, c - 1);
+        }
+    }
+}
+
+void FloorMap::set(std::size_t r, std::size_t c) {
+    std::size_t cell = index(r, c);
+    if (present[cell]) return;
+    present[cell] = 1;
+    accessible_ = accessible_ + (counts[cell] < 4);
+    for (std::size_t row = cell - width; row <= cell + width; row += width) {
+        for (std::size_t neighbour = row - 1; neighbour <= row + 1; neighbour++) {
+            if (neighbour == cell) continue;
+            // A roll with 3 neighbours gets its fourth and is no longer accessible
+            accessible_ = accessible_ - (present[neighbour] & (counts[neighbour] == 3));
+            counts[neighbour]++;
+        }
+    }
+}
+
+void FloorMap::clear(std::size_t r, std::size_t c) {
+    std::size_t cell = index(r, c);
+    if (!present[cell]) return;
+    present[cell] = 0;
+    accessible_ = accessible_ - (counts[cell] < 4);
+    for (std::size_t row = cell - width; row <= cell + width; row += width) {
+        for (std::size_t neighbour = row - 1; neighbour <= row + 1; neighbour++) {
+            if (neighbour == cell) continue;
+            counts[neighbour]--;
+            accessible_ = accessible_ + (present[neighbour] & (counts[neighbour] == 3));
+        }
+    }
+}
+
+void FloorMap::apply(std::span<const Edit> edits) {
+    for (const auto& edit : edits) index(edit.row, edit.col);
+    for (const auto& edit : edits) {
+        if (edit.roll) set(edit.row, edit.col);
+        else clear(edit.row, edit.col);
+    }
+}
+
+} // namespace day4
@@ -0,0 +1,182 @@
+/* Day 4: Printing Department
+https://adventofcode.com/2025/day/4
+*/
+
+#ifndef AOC_2025_DAY4_H
+#define AOC_2025_DAY4_H
+
+#include <algorithm>
+#include <assert.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../common/parallel.h"
+#include "../common/snapshot.h"
+
+namespace day4 {
+
+std::vector<std::vector<unsigned int>> readPuzzleInput(std::string filename);
+unsigned int countAccessibleRolls(std::vector<unsigned int>& top,
+     std::vector<unsigned int>& row, std::vector<unsigned int>& bottom);
+unsigned int solvePuzzle(std::string inputfile);
+
+// Read-only PackedGrid (below) layout over bits stored elsewhere, e.g. in a snapshot
+struct PackedGridView {
+    std::size_t rows = 0;
+    std::size_t cols = 0;
+    std::size_t wordsPerRow = 0;
+    const uint64_t* bits = nullptr;
+
+    const uint64_t* row(std::size_t paddedRow) const {
+        return bits + paddedRow * wordsPerRow;
+    }
+};
+
+// Grid with one bit per cell. Each row is stored in wordsPerRow 64-bit words, and
+// there is an empty padding row above and below the grid. Cell (r, c) is bit c % 64
+// of word c / 64 in row r + 1.
+struct PackedGrid {
+    std::size_t rows = 0;
+    std::size_t cols = 0;
+    std::size_t wordsPerRow = 0;
+    std::vector<uint64_t> bits;
+
+    const uint64_t* row(std::size_t paddedRow) const {
+        return bits.data() + paddedRow * wordsPerRow;
+    }
+    uint64_t* row(std::size_t paddedRow) {
+        return bits.data() + paddedRow * wordsPerRow;
+    }
+    operator PackedGridView() const {
+        return {rows, cols, wordsPerRow, bits.data()};
+    }
+};
+
+PackedGrid packGrid(const std::vector<std::vector<unsigned int>>& grid);
+PackedGrid readPackedPuzzleInput(std::string filename);
+uint64_t fewerThanFourNeighbours(uint64_t n0, uint64_t n1, uint64_t n2, uint64_t n3,
+     uint64_t n4, uint64_t n5, uint64_t n6, uint64_t n7);
+unsigned long int countAccessibleRollsPacked(const PackedGridView& grid);
+// Accessible rolls in rows [rowBegin, rowEnd) and words [wordBegin, wordEnd) of each row
+unsigned long int countAccessibleRollsPacked(const PackedGridView& grid, std::size_t rowBegin, std::size_t rowEnd,
+     std::size_t wordBegin, std::size_t wordEnd);
+
+std::vector<std::vector<uint8_t>> toByteGrid(const std::vector<std::vector<unsigned int>>& grid);
+
+// Kernels counting the accessible rolls in a padded byte row, given the rows above and below
+using RowKernel = unsigned int (*)(const uint8_t* top, const uint8_t* row, const uint8_t* bottom, std::size_t size);
+
+unsigned int countAccessibleRollsScalar(const uint8_t* top, const uint8_t* row, const uint8_t* bottom, std::size_t size);
+#if defined(__x86_64__) || defined(__i386__)
+unsigned int countAccessibleRollsSSE2(const uint8_t* top, const uint8_t* row, const uint8_t* bottom, std::size_t size);
+unsigned int countAccessibleRollsAVX2(const uint8_t* top, const uint8_t* row, const uint8_t* bottom, std::size_t size);
+#endif
+RowKernel selectRowKernel();
+unsigned int countAccessibleRolls(const std::vector<uint8_t>& top,
+     const std::vector<uint8_t>& row, const std::vector<uint8_t>& bottom);
+
+// Geometry of a tiled sweep. The rows are split into bands of bandRows rows, which
+// the threads take one at a time. A band is swept one tile of tileCols columns at a
+// time, so the three row segments a tile reads stay in cache while it is swept. The
+// rows just above and below a band (its halo) are read from the neighbouring bands.
+struct SweepGeometry {
+    std::size_t bandRows = 64;
+    std::size_t tileCols = 16384;
+};
+
+// Count the accessible rolls of a rows x cols grid by bands and tiles, on a pool of
+// threads that each sum into their own count. countTile(rowBegin, rowEnd, colBegin,
+// colEnd) counts a tile of a given layout; tile columns are rounded up to a multiple
+// of colStep (64 for bit-packed rows, so that tiles start on a word).
+template <typename CountTile>
+unsigned long int sweepTiles(std::size_t rows, std::size_t cols, SweepGeometry geometry,
+     unsigned int threads, std::size_t colStep, CountTile&& countTile) {
+    const std::size_t bandRows = std::max<std::size_t>(1, geometry.bandRows);
+    const std::size_t tileCols = (std::max<std::size_t>(1, geometry.tileCols) + colStep - 1) / colStep * colStep;
+    const std::size_t bands = (rows + bandRows - 1) / bandRows;
+
+    return parallelSum(bands, threads, [&](std::size_t band) {
+        std::size_t rowBegin = band * bandRows;
+        std::size_t rowEnd = std::min(rows, rowBegin + bandRows);
+        unsigned long int sum = 0;
+        for (std::size_t colBegin = 0; colBegin < cols; colBegin += tileCols) {
+            std::size_t colEnd = std::min(cols, colBegin + tileCols);
+            sum = sum + countTile(rowBegin, rowEnd, colBegin, colEnd);
+        }
+        return sum;
+    });
+}
+
+unsigned long int countAccessibleRollsTiled(const PackedGridView& grid, SweepGeometry geometry = SweepGeometry(),
+     unsigned int threads = defaultThreadCount());
+// grid is a padded byte grid as returned by toByteGrid
+unsigned long int countAccessibleRollsTiled(const std::vector<std::vector<uint8_t>>& grid,
+     SweepGeometry geometry = SweepGeometry(), unsigned int threads = defaultThreadCount());
+unsigned long int solvePuzzleTiled(std::string inputfile, SweepGeometry geometry = SweepGeometry(),
+     unsigned int threads = defaultThreadCount());
+
+struct RemovalResult {
+    unsigned long int removed = 0;
+    unsigned int rounds = 0;
+};
+
+RemovalResult removeAccessibleRollsByRescan(std::vector<std::vector<unsigned int>> grid);
+RemovalResult removeAccessibleRolls(const std::vector<std::vector<unsigned int>>& grid);
+RemovalResult removeAccessibleRolls(const PackedGridView& grid);
+
+// Binary snapshot of the grid (see common/snapshot.h): rows, cols and wordsPerRow
+// (uint64_t), then the bits of the PackedGrid, padding rows included
+void writeSnapshot(const std::string& inputfile, const std::string& snapshotfile);
+// Snapshot of inputfile at snapshotfile, written first when it is missing or stale
+Snapshot openSnapshot(const std::string& inputfile, const std::string& snapshotfile, bool verify = false);
+PackedGridView snapshotGrid(const Snapshot& snapshot);
+unsigned long int solveSnapshot(const Snapshot& snapshot, unsigned int threads = defaultThreadCount());
+
+// Grid that can be edited while keeping the number of accessible rolls up to date.
+// It uses the padded layout of readPuzzleInput, flattened, with the number of
+// neighbouring rolls of every cell. Placing or removing a roll only updates the
+// counts in its 3x3 neighbourhood, and the total of the rolls whose count changes
+// across 4. Rows and columns are those of the puzzle, without the padding.
+class FloorMap {
+public:
+    struct Edit {
+        std::size_t row;
+        std::size_t col;
+        bool roll;
+    };
+
+    explicit FloorMap(const std::vector<std::vector<unsigned int>>& grid);
+
+    std::size_t rows() const { return height - 2; }
+    std::size_t cols() const { return width - 2; }
+    bool get(std::size_t r, std::size_t c) const { return present[index(r, c)]; }
+    unsigned long int accessible() const { return accessible_; }
+
+    void set(std::size_t r, std::size_t c);
+    void clear(std::size_t r, std::size_t c);
+    // Checks every edit before applying any, so a batch with a bad edit changes nothing
+    void apply(std::span<const Edit> edits);
+
+private:
+    // Edits come from outside the input, so they are checked in every build
+    std::size_t index(std::size_t r, std::size_t c) const {
+        if (r >= rows() || c >= cols()) {
+            throw std::out_of_range("Cell outside the floor: row " + std::to_string(r) + ", column " + std::to_string(c));
+        }
+        return (r + 1) * width + c + 1;
+    }
+
+    std::size_t width;
+    std::size_t height;
+    std::vector<uint8_t> present;
+    std::vector<uint8_t> counts;
+    unsigned long int accessible_ = 0;
+};
+
+} // namespace day4
+
+#endif
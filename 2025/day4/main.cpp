@@ -0,0 +1,27 @@
+/* Command line interface for Day 4
+
+Usage: day4 [input]
+
+Solves the puzzle for input (default input_day4.txt): the rolls accessible at
+once, and the rolls removed by repeatedly removing the accessible ones.
+*/
+
+#include <iostream>
+#include <string>
+
+#include "day4.h"
+
+using namespace day4;
+
+int main(int argc, char** argv) {
+
+    std::string inputfile = (argc >= 2) ? argv[1] : "input_day4.txt";
+
+    unsigned long int solution = solvePuzzle(inputfile);
+    std::cout << "The solution is: " << solution << std::endl;
+
+    auto removed = removeAccessibleRolls(readPuzzleInput(inputfile));
+    std::cout << "Rolls removed: " << removed.removed << " in " << removed.rounds << " rounds" << std::endl;
+
+    return 0;
+}
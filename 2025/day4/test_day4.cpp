@@ -0,0 +1,220 @@
+/* Tests for Day 4, run from the day4 directory */
+
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "day4.h"
+#include "../common/check.h"
+#include "../common/decode.h"
+
+using namespace day4;
+
+int main() {
+
+    const std::string snapshotFile = scratchFile("snapshot_day4.tmp");
+
+    // Test readPuzzleInput
+    auto actual = readPuzzleInput("testinput_day4.txt");
+    CHECK(actual.size() == 12);
+    CHECK((actual[1] == std::vector<unsigned int>{0,0,0,1,1,0,1,1,1,1,0,0}));
+    CHECK((actual[2] == std::vector<unsigned int>{0,1,1,1,0,1,0,1,0,1,1,0}));
+    CHECK((actual[3] == std::vector<unsigned int>{0,1,1,1,1,1,0,1,0,1,1,0}));
+    CHECK((actual[4] == std::vector<unsigned int>{0,1,0,1,1,1,1,0,0,1,0,0}));
+    CHECK((actual[5] == std::vector<unsigned int>{0,1,1,0,1,1,1,1,0,1,1,0}));
+    CHECK((actual[6] == std::vector<unsigned int>{0,0,1,1,1,1,1,1,1,0,1,0}));
+    CHECK((actual[7] == std::vector<unsigned int>{0,0,1,0,1,0,1,0,1,1,1,0}));
+    CHECK((actual[8] == std::vector<unsigned int>{0,1,0,1,1,1,0,1,1,1,1,0}));
+    CHECK((actual[9] == std::vector<unsigned int>{0,0,1,1,1,1,1,1,1,1,0,0}));
+    CHECK((actual[10] == std::vector<unsigned int>{0,1,0,1,0,1,1,1,0,1,0,0}));
+    std::cout << "All tests for readPuzzleInput pass!" << std::endl;
+    
+    // Tests countAccessibleRolls
+    CHECK(countAccessibleRolls(actual[0], actual[1], actual[2]) == 5);
+    CHECK(countAccessibleRolls(actual[1], actual[2], actual[3]) == 1);
+    CHECK(countAccessibleRolls(actual[2], actual[3], actual[4]) == 1);
+    CHECK(countAccessibleRolls(actual[3], actual[4], actual[5]) == 0);
+    CHECK(countAccessibleRolls(actual[4], actual[5], actual[6]) == 2);
+    CHECK(countAccessibleRolls(actual[5], actual[6], actual[7]) == 0);
+    CHECK(countAccessibleRolls(actual[6], actual[7], actual[8]) == 0);
+    CHECK(countAccessibleRolls(actual[7], actual[8], actual[9]) == 1);
+    CHECK(countAccessibleRolls(actual[8], actual[9], actual[10]) == 0);
+    CHECK(countAccessibleRolls(actual[9], actual[10], actual[11]) == 3);
+    std::cout << "All tests for countAccessibleRolls pass!" << std::endl;
+
+    // Tests for the packed grid
+    auto packed = packGrid(actual);
+    CHECK(packed.rows == 10 && packed.cols == 10 && packed.wordsPerRow == 1);
+    CHECK(packed.bits.size() == 12);
+    CHECK(packed.bits[0] == 0 && packed.bits[11] == 0);
+    CHECK(packed.bits[1] == 0b0111101100);
+    CHECK(readPackedPuzzleInput("testinput_day4.txt").bits == packed.bits);
+    CHECK(countAccessibleRollsPacked(packed) == 13);
+    // Rows wider than one word, to check the neighbours across word boundaries
+    std::vector<std::vector<unsigned int>> wide(5, std::vector<unsigned int>(202, 0));
+    for (std::size_t c = 1; c < 201; c++) {
+        wide[1][c] = 1;
+        wide[2][c] = (c % 3 != 0);
+        wide[3][c] = (c % 5 == 1 || c % 7 == 2);
+    }
+    unsigned int expected = 0;
+    for (std::size_t r = 1; r < wide.size() - 1; r++) {
+        expected = expected + countAccessibleRolls(wide[r-1], wide[r], wide[r+1]);
+    }
+    CHECK(countAccessibleRollsPacked(packGrid(wide)) == expected);
+    CHECK(countAccessibleRollsPacked(readPackedPuzzleInput("input_day4.txt")) == solvePuzzle("input_day4.txt"));
+    std::cout << "All tests for countAccessibleRollsPacked pass!" << std::endl;
+
+    // Test the roll decoders on rows spanning several words, with a partial last word
+    std::mt19937 textRng(4);
+    std::string text(150, '.');
+    for (auto& c : text) c = (textRng() % 2) ? '@' : '.';
+    std::vector<RollDecoder> decoders = {decodeRollsScalar, selectRollDecoder()};
+    for (auto decoder : decoders) {
+        std::vector<uint64_t> bits(3, ~uint64_t(0));
+        CHECK(decoder(text.data(), text.size(), bits.data()) == text.size());
+        for (std::size_t c = 0; c < text.size(); c++) {
+            CHECK(((bits[c / 64] >> (c % 64)) & 1) == (text[c] == '@'));
+        }
+        CHECK(bits[2] >> (150 - 128) == 0);
+        for (std::size_t bad : {0, 31, 32, 63, 64, 100, 149}) {
+            std::string invalid = text;
+            invalid[bad] = 'x';
+            CHECK(decoder(invalid.data(), invalid.size(), bits.data()) == bad);
+        }
+    }
+    std::cout << "All tests for decodeRolls pass!" << std::endl;
+
+    // Differential tests of the byte kernels against countAccessibleRolls on random grids
+    std::vector<RowKernel> kernels = {countAccessibleRollsScalar};
+#if defined(__x86_64__) || defined(__i386__)
+    kernels.push_back(countAccessibleRollsSSE2);
+    if (__builtin_cpu_supports("avx2")) kernels.push_back(countAccessibleRollsAVX2);
+#endif
+    std::mt19937 rng(2025);
+    for (int t = 0; t < 200; t++) {
+        std::size_t rows = 3 + rng() % 10;
+        std::size_t cols = 3 + rng() % 150;
+        std::bernoulli_distribution occupied(0.1 + 0.8 * (rng() % 100) / 100.0);
+        std::vector<std::vector<unsigned int>> grid(rows, std::vector<unsigned int>(cols, 0));
+        for (std::size_t r = 1; r < rows - 1; r++) {
+            for (std::size_t c = 1; c < cols - 1; c++) grid[r][c] = occupied(rng);
+        }
+        auto bytes = toByteGrid(grid);
+        for (std::size_t r = 1; r < rows - 1; r++) {
+            unsigned int expected = countAccessibleRolls(grid[r-1], grid[r], grid[r+1]);
+            for (auto kernel : kernels) {
+                CHECK(kernel(bytes[r-1].data(), bytes[r].data(), bytes[r+1].data(), cols) == expected);
+            }
+            CHECK(countAccessibleRolls(bytes[r-1], bytes[r], bytes[r+1]) == expected);
+        }
+    }
+    std::cout << "All tests for the byte kernels pass!" << std::endl;
+
+    // Tests for the tiled sweep, for both layouts against the untiled count, with
+    // tiles that do and do not line up with the grid and the words
+    std::vector<std::vector<unsigned int>> large(302, std::vector<unsigned int>(259, 0));
+    for (std::size_t r = 1; r < large.size() - 1; r++) {
+        for (std::size_t c = 1; c < large[r].size() - 1; c++) large[r][c] = (rng() % 10) < 6;
+    }
+    auto largePacked = packGrid(large);
+    auto largeBytes = toByteGrid(large);
+    unsigned long int largeExpected = countAccessibleRollsPacked(largePacked);
+    for (SweepGeometry geometry : {SweepGeometry(), SweepGeometry{1, 1}, SweepGeometry{7, 64},
+         SweepGeometry{300, 100}, SweepGeometry{1000, 1000}, SweepGeometry{0, 0}}) {
+        for (unsigned int threads : {1u, 3u, 8u}) {
+            CHECK(countAccessibleRollsTiled(largePacked, geometry, threads) == largeExpected);
+            CHECK(countAccessibleRollsTiled(largeBytes, geometry, threads) == largeExpected);
+        }
+    }
+    CHECK(countAccessibleRollsTiled(packed) == 13);
+    CHECK(countAccessibleRollsTiled(toByteGrid(actual)) == 13);
+    CHECK(solvePuzzleTiled("input_day4.txt", SweepGeometry{16, 64}, 4) == solvePuzzle("input_day4.txt"));
+    std::cout << "All tests for countAccessibleRollsTiled pass!" << std::endl;
+
+    // Tests for removeAccessibleRolls
+    auto removal = removeAccessibleRolls(actual);
+    auto expected_removal = removeAccessibleRollsByRescan(actual);
+    CHECK(removal.removed == 43 && expected_removal.removed == 43);
+    CHECK(removal.rounds == expected_removal.rounds);
+    for (int t = 0; t < 50; t++) {
+        std::size_t rows = 3 + rng() % 40;
+        std::size_t cols = 3 + rng() % 40;
+        std::bernoulli_distribution occupied(0.3 + 0.7 * (rng() % 100) / 100.0);
+        std::vector<std::vector<unsigned int>> grid(rows, std::vector<unsigned int>(cols, 0));
+        for (std::size_t r = 1; r < rows - 1; r++) {
+            for (std::size_t c = 1; c < cols - 1; c++) grid[r][c] = occupied(rng);
+        }
+        auto result = removeAccessibleRolls(grid);
+        auto expected_result = removeAccessibleRollsByRescan(grid);
+        CHECK(result.removed == expected_result.removed && result.rounds == expected_result.rounds);
+    }
+    std::cout << "All tests for removeAccessibleRolls pass!" << std::endl;
+
+    // Tests for FloorMap, against a full recount after every batch of edits
+    FloorMap floor(actual);
+    CHECK(floor.rows() == 10 && floor.cols() == 10 && floor.accessible() == 13);
+    CHECK(floor.get(0, 2) && !floor.get(0, 0));
+    floor.set(0, 2);
+    CHECK(floor.accessible() == 13);
+    floor.clear(0, 0);
+    CHECK(floor.accessible() == 13);
+    auto edited = actual;
+    for (int t = 0; t < 200; t++) {
+        std::vector<FloorMap::Edit> edits(1 + rng() % 20);
+        for (auto& edit : edits) {
+            edit = {rng() % 10, rng() % 10, (rng() % 2) == 0};
+            edited[edit.row + 1][edit.col + 1] = edit.roll;
+        }
+        floor.apply(edits);
+        unsigned long int expected_total = 0;
+        for (std::size_t r = 1; r < edited.size() - 1; r++) {
+            expected_total = expected_total + countAccessibleRolls(edited[r-1], edited[r], edited[r+1]);
+        }
+        CHECK(floor.accessible() == expected_total);
+    }
+    // Edits outside the floor throw, and a batch holding one is not applied at all
+    unsigned long int before = floor.accessible();
+    unsigned int thrown = 0;
+    for (auto cell : {std::pair<std::size_t, std::size_t>{10, 0}, {0, 10}, {SIZE_MAX, 0}}) {
+        try {
+            floor.set(cell.first, cell.second);
+        }
+        catch (const std::out_of_range&) {
+            thrown++;
+        }
+        try {
+            floor.clear(cell.first, cell.second);
+        }
+        catch (const std::out_of_range&) {
+            thrown++;
+        }
+    }
+    std::vector<FloorMap::Edit> bad_batch = {{0, 0, !floor.get(0, 0)}, {3, 10, true}};
+    try {
+        floor.apply(bad_batch);
+    }
+    catch (const std::out_of_range&) {
+        thrown++;
+    }
+    CHECK(thrown == 7 && floor.accessible() == before && floor.get(0, 0) == bool(edited[1][1]));
+    std::cout << "All tests for FloorMap pass!" << std::endl;
+
+    // Check tests for snapshots pass
+    std::remove(snapshotFile.c_str());
+    for (auto file : {"testinput_day4.txt", "input_day4.txt"}) {
+        Snapshot snapshot = openSnapshot(file, snapshotFile);
+        CHECK(solveSnapshot(snapshot) == solvePuzzle(file));
+        CHECK(removeAccessibleRolls(snapshotGrid(snapshot)).removed == removeAccessibleRolls(readPuzzleInput(file)).removed);
+        CHECK(removeAccessibleRolls(snapshotGrid(snapshot)).rounds == removeAccessibleRolls(readPuzzleInput(file)).rounds);
+    }
+    std::remove(snapshotFile.c_str());
+    std::cout << "Tests for snapshots pass" << std::endl;
+
+    return 0;
+}
@@ -38,22 +38,30 @@ Process the database file from the new inventory management system. How many of
 
 */
 
+#include "day5.h"
+
+#include <algorithm>
 #include <iostream>
-#include <fstream>
-#include <vector>
-#include <assert.h>
+#include <stdexcept>
+#include <utility>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "../common/input.h"
+#include "../common/profile.h"
+
+namespace day5 {
 
 std::pair<std::vector<std::pair<unsigned long int, unsigned long int>>, std::vector<unsigned long int>> readPuzzleInput(std::string filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Failed to open file: " + filename);
-    }
+    AOC_PROFILE_SCOPE("day5::readPuzzleInput");
+    LineReader file(filename);
 
     std::vector<std::pair<unsigned long int, unsigned long int>> ranges;
     std::vector<unsigned long int> IDs;
     bool reading_ranges = true;
-    std::string line;
-    while (std::getline(file, line)) {
+    std::string_view line;
+    while (file.next(line)) {
         if (line.empty()) {
             reading_ranges = false;
             continue;
@@ -61,56 +69,325 @@ std::pair<std::vector<std::pair<unsigned long int, unsigned long int>>, std::vec
 
         if(reading_ranges){
             auto dashPos = line.find('-');
-            if (dashPos == std::string::npos) throw std::runtime_error("Invalid range: " + line);
-            ranges.emplace_back(std::stoul(line.substr(0,dashPos)), std::stoul(line.substr(dashPos+1)));
+            if (dashPos == std::string_view::npos) throw std::runtime_error("Invalid range: " + std::string(line));
+            ranges.emplace_back(parseNumber<unsigned long int>(line.substr(0,dashPos)), parseNumber<unsigned long int>(line.substr(dashPos+1)));
         }
         else {
-            IDs.push_back(std::stoul(line));
+            IDs.push_back(parseNumber<unsigned long int>(line));
         }
     }
+    AOC_PROFILE_COUNT("day5::readPuzzleInput", ranges.size() + IDs.size());
     return {ranges, IDs};
 }
 
+FreshReport::FreshReport(const std::string& filename, Format format) : format(format) {
+    file = (filename == "-") ? stdout : std::fopen(filename.c_str(), "wb");
+    if (!file) {
+        throw std::runtime_error("Failed to open file: " + filename);
+    }
+    buffer.reserve(bufferSize);
+}
+
+// Errors while closing are reported by close(); a report destroyed without it
+// drops them, since a destructor must not throw
+FreshReport::~FreshReport() {
+    try {
+        close();
+    }
+    catch (const std::runtime_error&) {
+    }
+}
+
+void FreshReport::close() {
+    if (!file) return;
+    if (format == BITMAP && bits > 0) buffer.push_back(static_cast<char>(pending));
+    bits = 0;
+    std::FILE* closing = std::exchange(file, nullptr);
+    bool ok = std::fwrite(buffer.data(), 1, buffer.size(), closing) == buffer.size();
+    buffer.clear();
+    ok = ((closing == stdout) ? std::fflush(closing) : std::fclose(closing)) == 0 && ok;
+    if (!ok) {
+        throw std::runtime_error("Failed to write fresh IDs");
+    }
+}
+
+void FreshReport::flush() {
+    if (!buffer.empty() && std::fwrite(buffer.data(), 1, buffer.size(), file) != buffer.size()) {
+        throw std::runtime_error("Failed to write fresh IDs");
+    }
+    buffer.clear();
+}
 
-unsigned int countFreshProducts(const std::vector<std::pair<unsigned long int, unsigned long int>>& ranges, const std::vector<unsigned long int> IDs) {
+unsigned int countFreshProducts(const std::vector<std::pair<unsigned long int, unsigned long int>>& ranges, const std::vector<unsigned long int> IDs,
+     FreshReport* report) {
+    AOC_PROFILE_SCOPE("day5::countFreshProducts");
     unsigned int freshProducts = 0;
     for (auto id : IDs) {
+        bool fresh = false;
         for (auto range : ranges) {
             if (id >= range.first && id <= range.second){
-                freshProducts++;
-                std::cout << "Product "<<id<<" found!" << std::endl;
+                fresh = true;
                 break;
             }
         }
+        if (fresh) freshProducts++;
+        if (report) report->add(id, fresh);
+    }
+    AOC_PROFILE_COUNT("day5::countFreshProducts", IDs.size());
+    return freshProducts;
+}
+
+// Sort the ranges and merge the ones that overlap or touch, so that the result
+// is a list of disjoint ranges in increasing order
+std::vector<std::pair<unsigned long int, unsigned long int>> mergeRanges(std::vector<std::pair<unsigned long int, unsigned long int>> ranges) {
+    std::sort(ranges.begin(), ranges.end());
+
+    std::vector<std::pair<unsigned long int, unsigned long int>> merged;
+    for (auto range : ranges) {
+        if (!merged.empty() && (range.first <= merged.back().second || range.first - merged.back().second == 1)) {
+            merged.back().second = std::max(merged.back().second, range.second);
+        }
+        else {
+            merged.push_back(range);
+        }
+    }
+    return merged;
+}
+
+// Binary search for the last merged range starting at or before the ID
+bool isFresh(const std::vector<std::pair<unsigned long int, unsigned long int>>& merged, unsigned long int id) {
+    auto it = std::upper_bound(merged.begin(), merged.end(), id,
+        [](unsigned long int value, const std::pair<unsigned long int, unsigned long int>& range) { return value < range.first; });
+    if (it == merged.begin()) return false;
+    return id <= std::prev(it)->second;
+}
+
+unsigned int countFreshProductsIndexed(const std::vector<std::pair<unsigned long int, unsigned long int>>& merged, const std::vector<unsigned long int>& IDs,
+     FreshReport* report) {
+    AOC_PROFILE_SCOPE("day5::countFreshProductsIndexed");
+    unsigned int freshProducts = 0;
+    for (auto id : IDs) {
+        bool fresh = isFresh(merged, id);
+        if (fresh) freshProducts++;
+        if (report) report->add(id, fresh);
+    }
+    return freshProducts;
+}
+
+// Sort the IDs and walk them together with the merged ranges in a single pass
+unsigned int countFreshProductsSorted(const std::vector<std::pair<unsigned long int, unsigned long int>>& merged, std::vector<unsigned long int> IDs) {
+    AOC_PROFILE_SCOPE("day5::countFreshProductsSorted");
+    std::sort(IDs.begin(), IDs.end());
+
+    unsigned int freshProducts = 0;
+    auto range = merged.begin();
+    for (auto id : IDs) {
+        while (range != merged.end() && range->second < id) range++;
+        if (range == merged.end()) break;
+        if (id >= range->first) freshProducts++;
     }
     return freshProducts;
 }
 
-unsigned int solvePuzzle(std::string inputfile) {
+// Does no I/O besides reading the input unless a report is given, which then
+// receives the IDs in input order
+unsigned int solvePuzzle(std::string inputfile, FreshReport* report) {
+    AOC_PROFILE_SCOPE("day5::solvePuzzle");
     auto testinput = readPuzzleInput(inputfile);
-    return countFreshProducts(testinput.first, testinput.second);
-}
-
-int main() {
-
-    auto testinput = readPuzzleInput("testinput_day5.txt");
-    auto test_ranges = std::move(testinput.first);
-    auto test_IDs = std::move(testinput.second);
-    std::vector<std::pair<unsigned long int, unsigned long int>> expected_ranges = {
-        {3,5}, {10,14}, {16,20}, {12,18}
-    };
-    std::vector<unsigned long int> expected_IDs = {1, 5, 8, 11, 17, 32};
-    assert(expected_ranges.size() == test_ranges.size());
-    assert(expected_ranges == test_ranges);
-    assert(expected_IDs.size() == test_IDs.size());
-    assert(expected_IDs == test_IDs);
-    std::cout << "All tests pass for readPuzzleInput" << std::endl;
-    
-    assert(solvePuzzle("testinput_day5.txt") == 3);
-    std::cout << "Test for solvePuzzle passes" << std::endl;
-
-    unsigned int solution = solvePuzzle("input_day5.txt");
-    std::cout << "The solution is: " << solution << std::endl;
-
-    return 0;
-}
\ No newline at end of file
+    auto merged = mergeRanges(testinput.first);
+    if (report) {
+        return countFreshProductsIndexed(merged, testinput.second, report);
+    }
+    return countFreshProductsSorted(merged, testinput.second);
+}
+
+// Number of distinct IDs covered by the ranges, from the sorted and merged ranges
+unsigned long int countFreshIDs(const std::vector<std::pair<unsigned long int, unsigned long int>>& ranges) {
+    unsigned long int total = 0;
+    for (auto range : mergeRanges(ranges)) {
+        total = total + (range.second - range.first + 1);
+    }
+    return total;
+}
+
+void FreshCoverage::add(unsigned long int first, unsigned long int last) {
+    if (first > last) {
+        throw std::invalid_argument("Invalid range: " + std::to_string(first) + "-" + std::to_string(last));
+    }
+
+    auto it = intervals.upper_bound(first);
+    if (it != intervals.begin()) {
+        auto prev = std::prev(it);
+        if (prev->second >= first || first - prev->second == 1) it = prev;
+    }
+    while (it != intervals.end() && (it->first <= last || it->first - last == 1)) {
+        first = std::min(first, it->first);
+        last = std::max(last, it->second);
+        total_ = total_ - (it->second - it->first + 1);
+        it = intervals.erase(it);
+    }
+    intervals.emplace_hint(it, first, last);
+    total_ = total_ + (last - first + 1);
+}
+
+FreshIndex::FreshIndex(const std::vector<std::pair<unsigned long int, unsigned long int>>& merged) {
+    std::size_t n = merged.size();
+    while ((std::size_t(1) << levels) - 1 < n) levels++;
+    std::size_t m = (std::size_t(1) << levels) - 1;
+
+    starts.assign(m + 1, ~0UL);
+    first.assign(m + 1, 1);
+    last.assign(m + 1, 0);
+    std::size_t rank = 0;
+    fill(1, m, merged, rank);
+    // Position 0: no start is greater than the ID, so the candidate is the last range
+    if (n > 0) {
+        first[0] = merged[n - 1].first;
+        last[0] = merged[n - 1].second;
+    }
+}
+
+void FreshIndex::query(const unsigned long int* ids, std::size_t size, uint64_t* bits) const {
+    static const auto kernel = selectKernel();
+    (this->*kernel)(ids, size, bits);
+}
+
+std::vector<uint64_t> FreshIndex::mask(std::span<const unsigned long int> ids) const {
+    std::vector<uint64_t> bits((ids.size() + 63) / 64, 0);
+    query(ids.data(), ids.size(), bits.data());
+    return bits;
+}
+
+std::size_t FreshIndex::count(std::span<const unsigned long int> ids) const {
+    constexpr std::size_t block = 4096;
+    std::size_t result = 0;
+    for (std::size_t offset = 0; offset < ids.size(); offset += block) {
+        uint64_t bits[block / 64] = {};
+        std::size_t size = std::min(block, ids.size() - offset);
+        query(ids.data() + offset, size, bits);
+        for (std::size_t w = 0; w < (size + 63) / 64; w++) result = result + __builtin_popcountll(bits[w]);
+    }
+    return result;
+}
+
+void FreshIndex::queryScalar(const unsigned long int* ids, std::size_t size, uint64_t* bits) const {
+    for (std::size_t i = 0; i < size; i++) {
+        bits[i / 64] |= uint64_t(contains(ids[i])) << (i % 64);
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("avx2")))
+void FreshIndex::queryAVX2(const unsigned long int* ids, std::size_t size, uint64_t* bits) const {
+    // Unsigned 64-bit compares are signed compares with the sign bits flipped
+    const __m256i sign = _mm256_set1_epi64x(0x8000000000000000LL);
+    const __m256i one = _mm256_set1_epi64x(1);
+    const long long* base = reinterpret_cast<const long long*>(starts.data());
+
+    std::size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ids + i));
+        __m256i xs = _mm256_xor_si256(x, sign);
+        __m256i k = one;
+        for (unsigned int level = 0; level < levels; level++) {
+            __m256i s = _mm256_i64gather_epi64(base, k, 8);
+            __m256i greater = _mm256_cmpgt_epi64(_mm256_xor_si256(s, sign), xs);
+            // k = 2k + 1 when starts[k] <= id, 2k otherwise
+            k = _mm256_add_epi64(_mm256_slli_epi64(k, 1), _mm256_andnot_si256(greater, one));
+        }
+        alignas(32) uint64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), k);
+        uint64_t fresh = 0;
+        for (int lane = 0; lane < 4; lane++) {
+            uint64_t j = lanes[lane] >> (__builtin_ctzll(~lanes[lane]) + 1);
+            fresh |= uint64_t((first[j] <= ids[i + lane]) & (ids[i + lane] <= last[j])) << lane;
+        }
+        bits[i / 64] |= fresh << (i % 64);
+    }
+    for (; i < size; i++) {
+        bits[i / 64] |= uint64_t(contains(ids[i])) << (i % 64);
+    }
+}
+#endif
+
+FreshIndex::Kernel FreshIndex::selectKernel() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return &FreshIndex::queryAVX2;
+#endif
+    return &FreshIndex::queryScalar;
+}
+
+// In-order walk of the implicit tree assigns the sorted starts (then the padding)
+void FreshIndex::fill(std::size_t k, std::size_t m, const std::vector<std::pair<unsigned long int, unsigned long int>>& merged, std::size_t& rank) {
+    if (k > m) return;
+    fill(2 * k, m, merged, rank);
+    if (rank < merged.size()) starts[k] = merged[rank].first;
+    // The range before this position in sorted order, if any
+    std::size_t previous = std::min(rank, merged.size());
+    if (previous > 0) {
+        first[k] = merged[previous - 1].first;
+        last[k] = merged[previous - 1].second;
+    }
+    rank++;
+    fill(2 * k + 1, m, merged, rank);
+}
+
+unsigned long int solvePuzzlePartTwo(std::string inputfile) {
+    AOC_PROFILE_SCOPE("day5::solvePuzzlePartTwo");
+    auto input = readPuzzleInput(inputfile);
+    return countFreshIDs(input.first);
+}
+
+void writeSnapshot(const std::string& inputfile, const std::string& snapshotfile) {
+    SourceStamp source = stampOf(inputfile, true);
+    auto input = readPuzzleInput(inputfile);
+    std::vector<uint64_t> bounds;
+    for (auto range : mergeRanges(input.first)) {
+        bounds.push_back(range.first);
+        bounds.push_back(range.second);
+    }
+    std::vector<uint64_t> IDs(input.second.begin(), input.second.end());
+    std::sort(IDs.begin(), IDs.end());
+    SnapshotWriter writer;
+    writer.add(std::span<const uint64_t>(bounds));
+    writer.add(std::span<const uint64_t>(IDs));
+    writer.write(snapshotfile, 5, source);
+}
+
+Snapshot openSnapshot(const std::string& inputfile, const std::string& snapshotfile, bool verify) {
+    return openSnapshotCache(inputfile, snapshotfile, 5, writeSnapshot, verify);
+}
+
+// The same sweep as countFreshProductsSorted, with both sides already sorted
+unsigned long int solveSnapshot(const Snapshot& snapshot) {
+    AOC_PROFILE_SCOPE("day5::solveSnapshot");
+    auto bounds = snapshot.section<uint64_t>(0);
+    auto IDs = snapshot.section<uint64_t>(1);
+    if (bounds.size() % 2 != 0) {
+        throw std::runtime_error("Invalid snapshot: odd number of range bounds");
+    }
+    unsigned long int freshProducts = 0;
+    std::size_t range = 0;
+    for (auto id : IDs) {
+        while (range < bounds.size() && bounds[range + 1] < id) range += 2;
+        if (range == bounds.size()) break;
+        if (id >= bounds[range]) freshProducts++;
+    }
+    return freshProducts;
+}
+
+unsigned long int solveSnapshotPartTwo(const Snapshot& snapshot) {
+    AOC_PROFILE_SCOPE("day5::solveSnapshotPartTwo");
+    auto bounds = snapshot.section<uint64_t>(0);
+    if (bounds.size() % 2 != 0) {
+        throw std::runtime_error("Invalid snapshot: odd number of range bounds");
+    }
+    unsigned long int total = 0;
+    for (std::size_t i = 0; i < bounds.size(); i += 2) {
+        total = total + (bounds[i + 1] - bounds[i] + 1);
+    }
+    return total;
+}
+
+} // namespace day5
@@ -0,0 +1,160 @@
+/* Day 5: Cafeteria
+https://adventofcode.com/2025/day/5
+*/
+
+#ifndef AOC_2025_DAY5_H
+#define AOC_2025_DAY5_H
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../common/snapshot.h"
+
+namespace day5 {
+
+std::pair<std::vector<std::pair<unsigned long int, unsigned long int>>, std::vector<unsigned long int>> readPuzzleInput(std::string filename);
+
+// Optional output stage listing the fresh IDs, written through a large buffer.
+// TEXT writes one fresh ID per line, BINARY each fresh ID as 8 native-endian bytes,
+// and BITMAP one bit per queried ID (fresh or not, in query order, LSB first).
+class FreshReport {
+public:
+    enum Format {TEXT, BINARY, BITMAP};
+    static constexpr std::size_t bufferSize = 1 << 20;
+
+    // filename "-" writes to stdout
+    FreshReport(const std::string& filename, Format format);
+
+    FreshReport(const FreshReport&) = delete;
+    FreshReport& operator=(const FreshReport&) = delete;
+
+    ~FreshReport();
+
+    // Write what is buffered and close the file, throwing if any write failed. The
+    // report must not be used afterwards.
+    void close();
+
+    void add(unsigned long int id, bool fresh) {
+        if (buffer.size() + 32 > bufferSize) flush();
+        if (format == BITMAP) {
+            pending |= uint8_t(fresh) << bits;
+            if (++bits == 8) {
+                buffer.push_back(static_cast<char>(pending));
+                pending = 0;
+                bits = 0;
+            }
+        }
+        else if (!fresh) {
+            return;
+        }
+        else if (format == TEXT) {
+            char text[24];
+            auto end = std::to_chars(text, text + sizeof(text) - 1, id).ptr;
+            *end++ = '\n';
+            buffer.insert(buffer.end(), text, end);
+        }
+        else {
+            const char* bytes = reinterpret_cast<const char*>(&id);
+            buffer.insert(buffer.end(), bytes, bytes + sizeof(id));
+        }
+    }
+
+    void flush();
+
+private:
+    Format format;
+    std::FILE* file;
+    std::vector<char> buffer;
+    uint8_t pending = 0;
+    unsigned int bits = 0;
+};
+
+unsigned int countFreshProducts(const std::vector<std::pair<unsigned long int, unsigned long int>>& ranges, const std::vector<unsigned long int> IDs,
+     FreshReport* report = nullptr);
+
+std::vector<std::pair<unsigned long int, unsigned long int>> mergeRanges(std::vector<std::pair<unsigned long int, unsigned long int>> ranges);
+bool isFresh(const std::vector<std::pair<unsigned long int, unsigned long int>>& merged, unsigned long int id);
+unsigned int countFreshProductsIndexed(const std::vector<std::pair<unsigned long int, unsigned long int>>& merged, const std::vector<unsigned long int>& IDs,
+     FreshReport* report = nullptr);
+unsigned int countFreshProductsSorted(const std::vector<std::pair<unsigned long int, unsigned long int>>& merged, std::vector<unsigned long int> IDs);
+unsigned int solvePuzzle(std::string inputfile, FreshReport* report = nullptr);
+
+unsigned long int countFreshIDs(const std::vector<std::pair<unsigned long int, unsigned long int>>& ranges);
+
+// Keeps the union of the ranges added so far as disjoint intervals in a balanced tree
+// (ordered by start), and the number of IDs they cover. Adding a range only touches
+// the intervals it overlaps or touches.
+class FreshCoverage {
+public:
+    void add(unsigned long int first, unsigned long int last);
+
+    unsigned long int total() const { return total_; }
+    std::size_t size() const { return intervals.size(); }
+
+private:
+    std::map<unsigned long int, unsigned long int> intervals;
+    unsigned long int total_ = 0;
+};
+
+// Merged ranges indexed for branch-free batch lookups. The range starts are stored in
+// Eytzinger (breadth-first) order, padded to a perfect tree with ULONG_MAX. A search
+// descends a fixed number of levels with k = 2k + (starts[k] <= id), which ends at the
+// position of the first start greater than the ID; the range before that one in sorted
+// order is the only range that can contain the ID. Its bounds are stored per position,
+// so the membership test has no branches, and four IDs can be searched at once with
+// AVX2 gathers.
+class FreshIndex {
+public:
+    explicit FreshIndex(const std::vector<std::pair<unsigned long int, unsigned long int>>& merged);
+
+    bool contains(unsigned long int id) const {
+        std::size_t k = 1;
+        for (unsigned int level = 0; level < levels; level++) {
+            k = 2 * k + (starts[k] <= id);
+        }
+        k = k >> (__builtin_ctzll(~k) + 1);
+        return (first[k] <= id) & (id <= last[k]);
+    }
+
+    // Set bit i of bits for every fresh ids[i]. bits must hold (size + 63) / 64 zeroed words.
+    void query(const unsigned long int* ids, std::size_t size, uint64_t* bits) const;
+    std::vector<uint64_t> mask(std::span<const unsigned long int> ids) const;
+    std::size_t count(std::span<const unsigned long int> ids) const;
+
+    using Kernel = void (FreshIndex::*)(const unsigned long int*, std::size_t, uint64_t*) const;
+
+    void queryScalar(const unsigned long int* ids, std::size_t size, uint64_t* bits) const;
+#if defined(__x86_64__) || defined(__i386__)
+    void queryAVX2(const unsigned long int* ids, std::size_t size, uint64_t* bits) const;
+#endif
+    static Kernel selectKernel();
+
+private:
+    void fill(std::size_t k, std::size_t m, const std::vector<std::pair<unsigned long int, unsigned long int>>& merged, std::size_t& rank);
+
+    unsigned int levels = 0;
+    std::vector<unsigned long int> starts;
+    std::vector<unsigned long int> first;
+    std::vector<unsigned long int> last;
+};
+
+unsigned long int solvePuzzlePartTwo(std::string inputfile);
+
+// Binary snapshot of the input (see common/snapshot.h): the merged ranges as
+// first, last pairs (uint64_t), then the IDs sorted
+void writeSnapshot(const std::string& inputfile, const std::string& snapshotfile);
+// Snapshot of inputfile at snapshotfile, written first when it is missing or stale
+Snapshot openSnapshot(const std::string& inputfile, const std::string& snapshotfile, bool verify = false);
+unsigned long int solveSnapshot(const Snapshot& snapshot);
+unsigned long int solveSnapshotPartTwo(const Snapshot& snapshot);
+
+} // namespace day5
+
+#endif
@@ -0,0 +1,47 @@
+/* Command line interface for Day 5
+
+Usage: day5 [input] [--quiet | --emit text|binary|bitmap [path]]
+
+Solves the puzzle for input (default input_day5.txt). --emit also writes the
+fresh IDs to path (default stdout), --quiet (the default) solves without any
+per-ID output.
+*/
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include "day5.h"
+#include "../common/input.h"
+
+using namespace day5;
+
+int main(int argc, char** argv) {
+
+    std::string inputfile = "input_day5.txt";
+    int arg = 1;
+    if (arg < argc && argv[arg][0] != '-') inputfile = argv[arg++];
+
+    std::unique_ptr<FreshReport> report;
+    if (arg + 1 < argc && std::string(argv[arg]) == "--emit") {
+        std::string format = argv[arg + 1];
+        std::string path = (arg + 2 < argc) ? argv[arg + 2] : "-";
+        if (format == "text") report = std::make_unique<FreshReport>(path, FreshReport::TEXT);
+        else if (format == "binary") report = std::make_unique<FreshReport>(path, FreshReport::BINARY);
+        else if (format == "bitmap") report = std::make_unique<FreshReport>(path, FreshReport::BITMAP);
+        else throw std::runtime_error("Unknown format: " + format);
+    }
+    else if (arg < argc && std::string(argv[arg]) != "--quiet") {
+        throw std::runtime_error("Unknown option: " + std::string(argv[arg]));
+    }
+
+    unsigned int solution = solvePuzzle(inputfile, report.get());
+    if (report) report->close();
+    std::cout << "The solution is: " << solution << std::endl;
+
+    unsigned long int freshIDs = solvePuzzlePartTwo(inputfile);
+    std::cout << "The number of fresh IDs is: " << freshIDs << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,171 @@
+/* Tests for Day 5, run from the day5 directory */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "day5.h"
+#include "../common/check.h"
+#include "../common/input.h"
+
+using namespace day5;
+
+int main() {
+
+    const std::string freshFile = scratchFile("fresh_day5.tmp");
+    const std::string snapshotFile = scratchFile("snapshot_day5.tmp");
+
+    auto testinput = readPuzzleInput("testinput_day5.txt");
+    auto test_ranges = std::move(testinput.first);
+    auto test_IDs = std::move(testinput.second);
+    std::vector<std::pair<unsigned long int, unsigned long int>> expected_ranges = {
+        {3,5}, {10,14}, {16,20}, {12,18}
+    };
+    std::vector<unsigned long int> expected_IDs = {1, 5, 8, 11, 17, 32};
+    CHECK(expected_ranges.size() == test_ranges.size());
+    CHECK(expected_ranges == test_ranges);
+    CHECK(expected_IDs.size() == test_IDs.size());
+    CHECK(expected_IDs == test_IDs);
+    std::cout << "All tests pass for readPuzzleInput" << std::endl;
+
+    auto test_merged = mergeRanges(test_ranges);
+    std::vector<std::pair<unsigned long int, unsigned long int>> expected_merged = {{3,5}, {10,20}};
+    CHECK(test_merged == expected_merged);
+    CHECK((mergeRanges({{1,2}, {3,4}, {7,9}, {8,8}}) == std::vector<std::pair<unsigned long int, unsigned long int>>{{1,4}, {7,9}}));
+    CHECK(mergeRanges({}).empty());
+    std::cout << "All tests pass for mergeRanges" << std::endl;
+
+    CHECK(!isFresh(test_merged, 1) && isFresh(test_merged, 3) && isFresh(test_merged, 5));
+    CHECK(!isFresh(test_merged, 8) && isFresh(test_merged, 11) && isFresh(test_merged, 17));
+    CHECK(isFresh(test_merged, 20) && !isFresh(test_merged, 21) && !isFresh(test_merged, 32));
+    CHECK(countFreshProductsIndexed(test_merged, test_IDs) == 3);
+    CHECK(countFreshProductsSorted(test_merged, test_IDs) == 3);
+    CHECK(countFreshProductsSorted(test_merged, {32, 17, 1, 11, 5, 8}) == 3);
+    CHECK(countFreshProducts(test_ranges, test_IDs) == 3);
+    {
+        FreshReport text(freshFile, FreshReport::TEXT);
+        CHECK(countFreshProducts(test_ranges, test_IDs, &text) == 3);
+    }
+    LineReader text_output(freshFile);
+    CHECK(text_output.contents() == "5\n11\n17\n");
+    {
+        FreshReport binary(freshFile, FreshReport::BINARY);
+        CHECK(countFreshProductsIndexed(test_merged, test_IDs, &binary) == 3);
+    }
+    LineReader binary_output(freshFile);
+    std::vector<unsigned long int> emitted(3);
+    CHECK(binary_output.contents().size() == sizeof(unsigned long int) * 3);
+    std::memcpy(emitted.data(), binary_output.contents().data(), binary_output.contents().size());
+    CHECK((emitted == std::vector<unsigned long int>{5, 11, 17}));
+    {
+        FreshReport bitmap(freshFile, FreshReport::BITMAP);
+        CHECK(solvePuzzle("testinput_day5.txt", &bitmap) == 3);
+    }
+    LineReader bitmap_output(freshFile);
+    CHECK(bitmap_output.contents() == std::string(1, char(0b11010)));
+    {
+        // A failed write is reported by close(), and ignored by the destructor
+        FreshReport full("/dev/full", FreshReport::TEXT);
+        full.add(5, true);
+        bool failed = false;
+        try {
+            full.close();
+        }
+        catch (const std::runtime_error&) {
+            failed = true;
+        }
+        CHECK(failed);
+        FreshReport dropped("/dev/full", FreshReport::BINARY);
+        dropped.add(5, true);
+    }
+    std::remove(freshFile.c_str());
+    std::cout << "All tests pass for countFreshProducts" << std::endl;
+
+    std::vector<FreshIndex::Kernel> kernels = {&FreshIndex::queryScalar};
+#if defined(__x86_64__) || defined(__i386__)
+    if (__builtin_cpu_supports("avx2")) kernels.push_back(&FreshIndex::queryAVX2);
+#endif
+    FreshIndex test_index(test_merged);
+    CHECK(test_index.count(test_IDs) == 3);
+    CHECK(test_index.mask(test_IDs) == std::vector<uint64_t>{0b11010});
+    for (unsigned long int id = 0; id < 25; id++) CHECK(test_index.contains(id) == isFresh(test_merged, id));
+    CHECK(FreshIndex({}).count(test_IDs) == 0);
+    FreshIndex edge_index({{0, 0}, {18446744073709551615UL, 18446744073709551615UL}});
+    CHECK(edge_index.contains(0) && !edge_index.contains(1) && edge_index.contains(18446744073709551615UL));
+    std::mt19937_64 index_rng(14);
+    for (int t = 0; t < 200; t++) {
+        std::vector<std::pair<unsigned long int, unsigned long int>> ranges(index_rng() % 40);
+        for (auto& range : ranges) {
+            range.first = index_rng() % 2000;
+            range.second = range.first + index_rng() % 30;
+        }
+        auto merged = mergeRanges(ranges);
+        FreshIndex index(merged);
+        std::vector<unsigned long int> IDs(index_rng() % 300);
+        for (auto& id : IDs) id = index_rng() % 2100;
+        std::vector<uint64_t> expected((IDs.size() + 63) / 64, 0);
+        for (std::size_t i = 0; i < IDs.size(); i++) expected[i / 64] |= uint64_t(isFresh(merged, IDs[i])) << (i % 64);
+        for (auto kernel : kernels) {
+            std::vector<uint64_t> bits((IDs.size() + 63) / 64, 0);
+            (index.*kernel)(IDs.data(), IDs.size(), bits.data());
+            CHECK(bits == expected);
+        }
+        CHECK(index.count(IDs) == countFreshProductsIndexed(merged, IDs));
+    }
+    std::cout << "All tests pass for FreshIndex" << std::endl;
+
+    CHECK(countFreshIDs(test_ranges) == 14);
+    CHECK(countFreshIDs({}) == 0);
+    CHECK(countFreshIDs({{1000000000000000, 1999999999999999}, {1500000000000000, 2999999999999999}}) == 2000000000000000);
+    FreshCoverage coverage;
+    for (auto range : test_ranges) coverage.add(range.first, range.second);
+    CHECK(coverage.total() == 14 && coverage.size() == 2);
+    coverage.add(6, 9);
+    CHECK(coverage.total() == 18 && coverage.size() == 1);
+    coverage.add(0, 18446744073709551614UL);
+    CHECK(coverage.total() == 18446744073709551615UL && coverage.size() == 1);
+    bool rejected = false;
+    try {
+        FreshCoverage reversed;
+        reversed.add(5, 3);
+    }
+    catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    CHECK(rejected);
+    std::mt19937_64 rng(5);
+    for (int t = 0; t < 100; t++) {
+        FreshCoverage incremental;
+        std::vector<std::pair<unsigned long int, unsigned long int>> added;
+        for (int i = 0; i < 50; i++) {
+            unsigned long int first = rng() % 1000;
+            unsigned long int last = first + rng() % 40;
+            incremental.add(first, last);
+            added.emplace_back(first, last);
+            CHECK(incremental.total() == countFreshIDs(added));
+            CHECK(incremental.size() == mergeRanges(added).size());
+        }
+    }
+    std::cout << "All tests pass for countFreshIDs" << std::endl;
+
+    CHECK(solvePuzzle("testinput_day5.txt") == 3);
+    CHECK(solvePuzzlePartTwo("testinput_day5.txt") == 14);
+    std::cout << "Test for solvePuzzle passes" << std::endl;
+
+    // Check tests for snapshots pass
+    std::remove(snapshotFile.c_str());
+    for (auto file : {"testinput_day5.txt", "input_day5.txt"}) {
+        Snapshot snapshot = openSnapshot(file, snapshotFile);
+        CHECK(solveSnapshot(snapshot) == solvePuzzle(file));
+        CHECK(solveSnapshotPartTwo(snapshot) == solvePuzzlePartTwo(file));
+    }
+    std::remove(snapshotFile.c_str());
+    std::cout << "Tests for snapshots pass" << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,162 @@
+/* Differential testing of the optimized solvers against the simple ones
+
+A property pairs a generator of random cases with an oracle, usually the original
+straightforward implementation, and the engines that must agree with it: the
+optimized paths (interval indexes, arithmetic sums, bit-packed grids, SIMD kernels,
+snapshots). Every engine of a property becomes a check. A check generates its case
+from a seed and a size, so any case can be generated again from the two numbers.
+
+When an engine disagrees with the oracle, or throws, the case is shrunk: the
+candidates of the property's shrink function are tried in order, and the first one
+that still fails replaces the case, until none of them fails. What is reported is
+then a minimal failing input rather than the random one that was generated.
+*/
+
+#ifndef AOC_2025_DIFFERENTIAL_H
+#define AOC_2025_DIFFERENTIAL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace differential {
+
+using Random = std::mt19937_64;
+using Answer = unsigned long int;
+
+template <typename Case>
+struct Property {
+    std::string name;
+    // A random case, size bounds the number of records and their magnitude
+    std::function<Case(Random& random, std::size_t size)> generate;
+    // Smaller cases derived from a case, most aggressive first
+    std::function<std::vector<Case>(const Case&)> shrink;
+    // The case in the puzzle's input format, for file based engines and reports
+    std::function<std::string(const Case&)> text;
+    std::function<Answer(const Case&)> oracle;
+    std::vector<std::pair<std::string, std::function<Answer(const Case&)>>> engines;
+};
+
+struct Failure {
+    std::string check{};
+    uint64_t seed = 0;
+    std::size_t size = 0;
+    unsigned int shrinks = 0;
+    std::string input{};
+    Answer expected = 0;
+    std::string actual{};
+};
+
+// One engine of one property, run on the case generated from a seed and size
+struct Check {
+    std::string name;
+    std::function<std::optional<Failure>(uint64_t seed, std::size_t size)> run;
+};
+
+// Seed of case i of a run, spread with splitmix64 so that nearby runs do not overlap
+inline uint64_t caseSeed(uint64_t seed, uint64_t i) {
+    uint64_t z = seed + (i + 1) * 0x9e3779b97f4a7c15UL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9UL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebUL;
+    return z ^ (z >> 31);
+}
+
+template <typename Case>
+void addChecks(std::vector<Check>& checks, Property<Case> property, unsigned int maxShrinkSteps = 2000) {
+    auto shared = std::make_shared<const Property<Case>>(std::move(property));
+    for (std::size_t e = 0; e < shared->engines.size(); e++) {
+        std::string name = shared->name + "/" + shared->engines[e].first;
+        checks.push_back({name, [shared, e, name, maxShrinkSteps](uint64_t seed, std::size_t size) -> std::optional<Failure> {
+            const auto& engine = shared->engines[e].second;
+            // Whether the engine disagrees with the oracle on c, with the answers in failure
+            auto fails = [&](const Case& c, Failure& failure) {
+                failure.expected = shared->oracle(c);
+                try {
+                    Answer answer = engine(c);
+                    if (answer == failure.expected) return false;
+                    failure.actual = std::to_string(answer);
+                }
+                catch (const std::exception& error) {
+                    failure.actual = std::string("exception: ") + error.what();
+                }
+                return true;
+            };
+
+            Random random(seed);
+            Case failing = shared->generate(random, size);
+            Failure failure{.check = name, .seed = seed, .size = size};
+            if (!fails(failing, failure)) return std::nullopt;
+
+            unsigned int steps = 0;
+            bool shrunk = true;
+            while (shrunk && steps < maxShrinkSteps) {
+                shrunk = false;
+                for (auto& smaller : shared->shrink(failing)) {
+                    if (++steps > maxShrinkSteps) break;
+                    Failure attempt = failure;
+                    if (fails(smaller, attempt)) {
+                        failing = std::move(smaller);
+                        failure = std::move(attempt);
+                        failure.shrinks++;
+                        shrunk = true;
+                        break;
+                    }
+                }
+            }
+            failure.input = shared->text(failing);
+            return failure;
+        }});
+    }
+}
+
+// Shrink candidates of a vector: without each chunk of half, a quarter, ... down to
+// single elements, then with each element replaced by one of its shrink candidates.
+// Vectors are not shrunk below minSize elements.
+template <typename T, typename ShrinkElement>
+std::vector<std::vector<T>> shrinkVector(const std::vector<T>& values, std::size_t minSize, ShrinkElement&& shrinkElement) {
+    std::vector<std::vector<T>> result;
+    for (std::size_t chunk = std::max<std::size_t>(1, values.size() / 2); chunk >= 1 && chunk <= values.size(); chunk /= 2) {
+        if (values.size() - chunk < minSize) continue;
+        for (std::size_t begin = 0; begin + chunk <= values.size(); begin += chunk) {
+            std::vector<T> smaller(values.begin(), values.begin() + begin);
+            smaller.insert(smaller.end(), values.begin() + begin + chunk, values.end());
+            result.push_back(std::move(smaller));
+        }
+    }
+    for (std::size_t i = 0; i < values.size(); i++) {
+        for (auto& element : shrinkElement(values[i])) {
+            std::vector<T> smaller = values;
+            smaller[i] = std::move(element);
+            result.push_back(std::move(smaller));
+        }
+    }
+    return result;
+}
+
+template <typename T>
+std::vector<std::vector<T>> shrinkVector(const std::vector<T>& values, std::size_t minSize) {
+    return shrinkVector(values, minSize, [](const T&) { return std::vector<T>(); });
+}
+
+// Shrink candidates of a number towards low: low itself, halfway, and one less
+inline std::vector<unsigned long int> shrinkNumber(unsigned long int value, unsigned long int low = 0) {
+    std::vector<unsigned long int> result;
+    if (value <= low) return result;
+    result.push_back(low);
+    unsigned long int half = low + (value - low) / 2;
+    if (half != low) result.push_back(half);
+    if (value - 1 != half && value - 1 != low) result.push_back(value - 1);
+    return result;
+}
+
+} // namespace differential
+
+#endif
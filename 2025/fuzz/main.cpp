@@ -0,0 +1,150 @@
+/* Differential tester of the 2025 solvers
+
+Usage: aoc_fuzz [--only TEXT] [--seed N] [--cases N] [--max-size N] [--seconds S]
+                [--replay SEED] [--list]
+
+Runs every check (an optimized engine against the simple oracle of its property,
+see properties.cpp), or those whose name contains TEXT, on --cases random cases
+each (default 100). Case i of a check is generated from the seed caseSeed(N, i) and
+a size cycling from 1 to --max-size (default 24), so the small cases come first.
+
+With --seconds, the checks are instead run in turn on fresh cases until S seconds
+have passed. Either way a check stops at its first failure. --replay runs the
+case generated from the given seed with size --max-size, as printed with a failure.
+
+A failure is printed with its shrunk input and the command that replays it. The
+exit status is 1 when any check failed.
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "properties.h"
+#include "../common/input.h"
+
+using namespace differential;
+
+void report(const Failure& failure) {
+    std::cout << "FAIL " << failure.check << " (seed " << failure.seed << ", size " << failure.size
+         << ", shrunk " << failure.shrinks << " times)" << std::endl;
+    std::cout << "  expected " << failure.expected << ", got " << failure.actual << std::endl;
+    std::cout << "  input:" << std::endl;
+    FieldSplitter lines(failure.input, '\n');
+    std::string_view line;
+    while (lines.next(line)) {
+        if (!line.empty()) std::cout << "    " << line << std::endl;
+    }
+    std::cout << "  replay: aoc_fuzz --only '" << failure.check << "' --replay " << failure.seed
+         << " --max-size " << failure.size << std::endl;
+}
+
+int main(int argc, char** argv) {
+
+    std::string only;
+    uint64_t seed = 1;
+    unsigned long int cases = 100;
+    std::size_t maxSize = 24;
+    double seconds = 0;
+    std::optional<uint64_t> replay;
+    bool list = false;
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--list") {
+            list = true;
+            continue;
+        }
+        if (i + 1 >= argc) throw std::runtime_error("Missing value for option: " + option);
+        std::string value = argv[++i];
+        if (option == "--only") only = value;
+        else if (option == "--seed") seed = parseNumber<uint64_t>(value);
+        else if (option == "--cases") cases = parseNumber<unsigned long int>(value);
+        else if (option == "--max-size") maxSize = parseNumber<std::size_t>(value);
+        else if (option == "--seconds") seconds = std::stod(value);
+        else if (option == "--replay") replay = parseNumber<uint64_t>(value);
+        else throw std::runtime_error("Unknown option: " + option);
+    }
+    if (maxSize == 0) throw std::runtime_error("--max-size must be at least 1");
+
+    std::vector<const Check*> selected;
+    for (const auto& check : checks()) {
+        if (check.name.find(only) != std::string::npos) selected.push_back(&check);
+    }
+    if (list) {
+        for (auto check : selected) std::cout << check->name << std::endl;
+        return 0;
+    }
+    if (selected.empty()) throw std::runtime_error("No check matches: " + only);
+
+    int status = 0;
+    if (replay) {
+        for (auto check : selected) {
+            auto failure = check->run(*replay, maxSize);
+            if (failure) {
+                report(*failure);
+                status = 1;
+            }
+            else {
+                std::cout << "pass " << check->name << std::endl;
+            }
+        }
+        return status;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto elapsed = [&] {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    };
+    std::vector<unsigned long int> passed(selected.size(), 0);
+    std::vector<bool> failed(selected.size(), false);
+    if (seconds > 0) {
+        // Round robin over the checks that have not failed yet
+        unsigned long int i = 0;
+        bool running = true;
+        while (running && elapsed() < seconds) {
+            running = false;
+            for (std::size_t c = 0; c < selected.size() && elapsed() < seconds; c++) {
+                if (failed[c]) continue;
+                running = true;
+                auto failure = selected[c]->run(caseSeed(seed, i), 1 + i % maxSize);
+                if (failure) {
+                    report(*failure);
+                    failed[c] = true;
+                    status = 1;
+                }
+                else {
+                    passed[c]++;
+                }
+            }
+            i++;
+        }
+    }
+    else {
+        for (std::size_t c = 0; c < selected.size(); c++) {
+            for (unsigned long int i = 0; i < cases && !failed[c]; i++) {
+                auto failure = selected[c]->run(caseSeed(seed, i), 1 + i % maxSize);
+                if (failure) {
+                    report(*failure);
+                    failed[c] = true;
+                    status = 1;
+                }
+                else {
+                    passed[c]++;
+                }
+            }
+        }
+    }
+
+    unsigned long int total = 0;
+    for (std::size_t c = 0; c < selected.size(); c++) {
+        std::cout << (failed[c] ? "FAIL " : "pass ") << selected[c]->name << ": " << passed[c] << " cases" << std::endl;
+        total = total + passed[c];
+    }
+    std::cout << total << " cases passed in " << elapsed() << " s" << std::endl;
+
+    return status;
+}
@@ -0,0 +1,710 @@
+/* Differential checks of the 2025 solvers */
+
+#include "properties.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <set>
+#include <string>
+#include <utility>
+
+#include <unistd.h>
+
+#include "day1.h"
+#include "day2.h"
+#include "day3.h"
+#include "day4.h"
+#include "day5.h"
+#include "generators.h"
+
+namespace differential {
+
+namespace {
+
+// Files for the engines that read their input from a file, rewritten for every case
+struct ScratchFiles {
+    std::string input;
+    std::string snapshot;
+
+    ScratchFiles() {
+        auto stem = std::filesystem::temp_directory_path() / ("aoc_fuzz_" + std::to_string(::getpid()));
+        input = stem.string() + ".txt";
+        snapshot = stem.string() + ".snap";
+    }
+    ~ScratchFiles() {
+        std::remove(input.c_str());
+        std::remove(snapshot.c_str());
+    }
+};
+
+ScratchFiles& scratch() {
+    static ScratchFiles files;
+    return files;
+}
+
+const std::string& inputFile(const std::string& text) {
+    generators::writeFile(scratch().input, text);
+    return scratch().input;
+}
+
+// Snapshot written from text, never one left over from an earlier case
+template <typename Open>
+Snapshot snapshotOf(const std::string& text, Open&& open) {
+    std::remove(scratch().snapshot.c_str());
+    return open(inputFile(text), scratch().snapshot, true);
+}
+
+using Range = std::pair<unsigned long int, unsigned long int>;
+
+// Day 1
+
+struct Rotations {
+    unsigned int start = 50;
+    std::vector<std::pair<day1::Direction, unsigned int>> steps;
+};
+
+std::string rotationText(const Rotations& c) {
+    std::string text;
+    for (auto step : c.steps) text += (step.first == day1::RIGHT ? "R" : "L") + std::to_string(step.second) + "\n";
+    return text;
+}
+
+Rotations generateRotations(Random& random, std::size_t size) {
+    Rotations c;
+    c.start = random() % 100;
+    std::size_t count = 1 + random() % (4 * size);
+    for (std::size_t i = 0; i < count; i++) {
+        day1::Direction dir = (random() & 1) ? day1::RIGHT : day1::LEFT;
+        unsigned int positions;
+        switch (random() % 3) {
+            // Near a whole turn, where landings and crossings are easiest to get wrong
+            case 0: positions = 100 * (random() % (size + 1)) + random() % 3; break;
+            case 1: positions = 1 + random() % 10; break;
+            default: positions = 1 + random() % (50 * size + 200); break;
+        }
+        c.steps.emplace_back(dir, positions == 0 ? 1 : positions);
+    }
+    return c;
+}
+
+std::vector<Rotations> shrinkRotations(const Rotations& c) {
+    std::vector<Rotations> result;
+    for (auto start : shrinkNumber(c.start)) result.push_back({static_cast<unsigned int>(start), c.steps});
+    auto steps = shrinkVector(c.steps, 1, [](const std::pair<day1::Direction, unsigned int>& step) {
+        std::vector<std::pair<day1::Direction, unsigned int>> smaller;
+        if (step.first == day1::RIGHT) smaller.emplace_back(day1::LEFT, step.second);
+        for (auto positions : shrinkNumber(step.second, 1)) smaller.emplace_back(step.first, positions);
+        return smaller;
+    });
+    for (auto& s : steps) result.push_back({c.start, std::move(s)});
+    return result;
+}
+
+void addDay1(std::vector<Check>& checks) {
+    Property<Rotations> landings{"day1 landings", generateRotations, shrinkRotations, rotationText,
+        [](const Rotations& c) {
+            unsigned int position = c.start;
+            unsigned long int zeros = 0;
+            for (auto step : c.steps) {
+                position = day1::rotateLock(position, step.first, step.second);
+                if (position == 0) zeros++;
+            }
+            return zeros;
+        }, {}};
+    landings.engines = {
+        {"applyRotation", [](const Rotations& c) {
+            day1::DialState state;
+            state.position = c.start;
+            for (auto step : c.steps) day1::applyRotation(state, step.first, step.second);
+            return state.zeros;
+        }},
+        {"composeTransfers", [](const Rotations& c) {
+            // Chunks of three rotations, composed left to right
+            std::vector<day1::Direction> dirs;
+            std::vector<unsigned int> numbers;
+            for (auto step : c.steps) {
+                dirs.push_back(step.first);
+                numbers.push_back(step.second);
+            }
+            day1::DialTransfer total = day1::buildTransfer(dirs.data(), numbers.data(), 0);
+            for (std::size_t begin = 0; begin < dirs.size(); begin += 3) {
+                std::size_t count = std::min<std::size_t>(3, dirs.size() - begin);
+                total = day1::composeTransfers(total, day1::buildTransfer(dirs.data() + begin, numbers.data() + begin, count));
+            }
+            return total.zeros[c.start];
+        }},
+        {"solvePuzzle", [](const Rotations& c) { return day1::solvePuzzle(c.start, inputFile(rotationText(c))); }},
+        {"solvePuzzleParallel", [](const Rotations& c) {
+            return day1::solvePuzzleParallel(c.start, inputFile(rotationText(c)), 2, 3);
+        }},
+        {"solveStream", [](const Rotations& c) {
+            day1::DialState state;
+            state.position = c.start;
+            return day1::solveStream(inputFile(rotationText(c)), state).zeros;
+        }},
+        {"solveSnapshot", [](const Rotations& c) {
+            return day1::solveSnapshot(snapshotOf(rotationText(c), day1::openSnapshot), c.start);
+        }},
+    };
+    addChecks(checks, std::move(landings));
+
+    Property<Rotations> crossings{"day1 crossings", generateRotations, shrinkRotations, rotationText,
+        [](const Rotations& c) {
+            // One click at a time
+            unsigned int position = c.start;
+            unsigned long int zeros = 0;
+            for (auto step : c.steps) {
+                for (unsigned int i = 0; i < step.second; i++) {
+                    position = day1::rotateLock(position, step.first, 1);
+                    if (position == 0) zeros++;
+                }
+            }
+            return zeros;
+        }, {}};
+    crossings.engines = {
+        {"countZeroCrossings", [](const Rotations& c) {
+            unsigned int position = c.start;
+            unsigned long int zeros = 0;
+            for (auto step : c.steps) {
+                zeros = zeros + day1::countZeroCrossings(position, step.first, step.second);
+                position = day1::rotateLock(position, step.first, step.second);
+            }
+            return zeros;
+        }},
+        {"solvePuzzle", [](const Rotations& c) {
+            return day1::solvePuzzle(c.start, inputFile(rotationText(c)), day1::CROSSINGS);
+        }},
+        {"solveSnapshot", [](const Rotations& c) {
+            return day1::solveSnapshot(snapshotOf(rotationText(c), day1::openSnapshot), c.start, day1::CROSSINGS);
+        }},
+    };
+    addChecks(checks, std::move(crossings));
+}
+
+// Day 2
+
+std::string rangeListText(const std::vector<Range>& ranges) {
+    std::string text;
+    for (std::size_t i = 0; i < ranges.size(); i++) {
+        if (i > 0) text += ',';
+        text += std::to_string(ranges[i].first) + "-" + std::to_string(ranges[i].second);
+    }
+    return text + "\n";
+}
+
+std::vector<Range> generateRangeList(Random& random, std::size_t size) {
+    std::vector<Range> ranges;
+    std::size_t count = 1 + random() % size;
+    unsigned long int width = 20 * size + 10;
+    for (std::size_t i = 0; i < count; i++) {
+        unsigned long int anchor;
+        switch (random() % 3) {
+            // A block of digits repeated, which is what the invalid IDs look like
+            case 0: {
+                unsigned int blockDigits = 1 + random() % 6;
+                unsigned int repeats = 2 + random() % (12 / blockDigits - 1);
+                unsigned long int low = 1;
+                for (unsigned int d = 1; d < blockDigits; d++) low = low * 10;
+                std::string block = std::to_string(low + random() % (9 * low));
+                std::string digits;
+                for (unsigned int r = 0; r < repeats; r++) digits += block;
+                anchor = std::stoul(digits);
+                break;
+            }
+            // A power of ten, where the number of digits changes
+            case 1: {
+                anchor = 1;
+                for (unsigned int d = random() % 12; d > 0; d--) anchor = anchor * 10;
+                break;
+            }
+            default: anchor = 1 + random() % 1000000000000UL; break;
+        }
+        unsigned long int below = random() % width;
+        unsigned long int first = (anchor > below) ? anchor - below : 1;
+        ranges.emplace_back(first, anchor + 1 + random() % width);
+    }
+    return ranges;
+}
+
+// Smaller ranges within a range, keeping first < last
+std::vector<Range> shrinkRange(const Range& range) {
+    auto [first, last] = range;
+    std::vector<Range> smaller;
+    if (last - first > 1) smaller.emplace_back(first, first + 1);
+    unsigned long int middle = first + (last - first) / 2;
+    if (middle > first && middle < last) {
+        smaller.emplace_back(middle, last);
+        smaller.emplace_back(first, middle);
+    }
+    if (first + 1 < last) {
+        smaller.emplace_back(first + 1, last);
+        smaller.emplace_back(first, last - 1);
+    }
+    // One digit less
+    if (first >= 10 && last / 10 > first / 10) smaller.emplace_back(first / 10, last / 10);
+    return smaller;
+}
+
+std::vector<std::vector<Range>> shrinkRangeList(const std::vector<Range>& ranges) {
+    return shrinkVector(ranges, 1, shrinkRange);
+}
+
+void addDay2(std::vector<Check>& checks) {
+    Property<std::vector<Range>> twice{"day2 twice", generateRangeList, shrinkRangeList, rangeListText,
+        [](const std::vector<Range>& ranges) {
+            unsigned long int result = 0;
+            for (auto range : ranges) {
+                for (auto id : day2::findInvalidIDs(range.first, range.second)) result = result + id;
+            }
+            return result;
+        }, {}};
+    twice.engines = {
+        {"sumInvalidIDs", [](const std::vector<Range>& ranges) {
+            unsigned long int result = 0;
+            for (auto range : ranges) result = result + day2::sumInvalidIDs(range.first, range.second);
+            return result;
+        }},
+        {"sumInvalidIDsByScan", [](const std::vector<Range>& ranges) {
+            unsigned long int result = 0;
+            for (auto range : ranges) result = result + day2::sumInvalidIDsByScan(range.first, range.second);
+            return result;
+        }},
+        {"sumRangesParallel", [](const std::vector<Range>& ranges) {
+            return day2::sumRangesParallel(ranges, day2::sumInvalidIDs, 3, 7);
+        }},
+        {"solvePuzzle", [](const std::vector<Range>& ranges) { return day2::solvePuzzle(inputFile(rangeListText(ranges))); }},
+        {"solvePuzzleParallel", [](const std::vector<Range>& ranges) {
+            return day2::solvePuzzleParallel(inputFile(rangeListText(ranges)), day2::TWICE, 2);
+        }},
+        {"solveSnapshot", [](const std::vector<Range>& ranges) {
+            return day2::solveSnapshot(snapshotOf(rangeListText(ranges), day2::openSnapshot));
+        }},
+    };
+    addChecks(checks, std::move(twice));
+
+    Property<std::vector<Range>> repeated{"day2 repeated", generateRangeList, shrinkRangeList, rangeListText,
+        [](const std::vector<Range>& ranges) {
+            unsigned long int result = 0;
+            for (auto range : ranges) {
+                for (auto id : day2::findRepeatedPatternIDs(range.first, range.second)) result = result + id;
+            }
+            return result;
+        }, {}};
+    repeated.engines = {
+        {"sumRepeatedPatternIDs", [](const std::vector<Range>& ranges) {
+            unsigned long int result = 0;
+            for (auto range : ranges) result = result + day2::sumRepeatedPatternIDs(range.first, range.second);
+            return result;
+        }},
+        {"sumRangesParallel", [](const std::vector<Range>& ranges) {
+            return day2::sumRangesParallel(ranges, day2::sumRepeatedPatternIDs, 3, 7);
+        }},
+        {"solvePuzzle", [](const std::vector<Range>& ranges) {
+            return day2::solvePuzzle(inputFile(rangeListText(ranges)), day2::REPEATED);
+        }},
+        {"solvePuzzleParallel", [](const std::vector<Range>& ranges) {
+            return day2::solvePuzzleParallel(inputFile(rangeListText(ranges)), day2::REPEATED, 2);
+        }},
+        {"solveSnapshot", [](const std::vector<Range>& ranges) {
+            return day2::solveSnapshot(snapshotOf(rangeListText(ranges), day2::openSnapshot), day2::REPEATED);
+        }},
+    };
+    addChecks(checks, std::move(repeated));
+}
+
+// Day 3
+
+using Banks = std::vector<std::vector<unsigned int>>;
+
+std::string bankText(const Banks& banks) {
+    std::string text;
+    for (auto& bank : banks) {
+        for (auto digit : bank) text += static_cast<char>('0' + digit);
+        text += '\n';
+    }
+    return text;
+}
+
+day3::BankBuffer bankBuffer(const Banks& banks) {
+    day3::BankBuffer buffer;
+    for (auto& bank : banks) {
+        buffer.digits.insert(buffer.digits.end(), bank.begin(), bank.end());
+        buffer.offsets.push_back(buffer.digits.size());
+    }
+    return buffer;
+}
+
+// Largest k digit joltage choosing each digit in turn as the first largest one that
+// leaves enough digits after it
+unsigned long int largestJoltageByWindow(const std::vector<unsigned int>& bank, std::size_t k) {
+    unsigned long int result = 0;
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i < k; i++) {
+        std::size_t best = begin;
+        for (std::size_t j = begin; j + (k - i) <= bank.size(); j++) {
+            if (bank[j] > bank[best]) best = j;
+        }
+        result = 10 * result + bank[best];
+        begin = best + 1;
+    }
+    return result;
+}
+
+Property<Banks> bankProperty(std::size_t k) {
+    Property<Banks> property;
+    property.name = "day3 " + std::to_string(k) + " batteries";
+    property.generate = [k](Random& random, std::size_t size) {
+        Banks banks(1 + random() % size);
+        for (auto& bank : banks) {
+            // Few distinct digits make ties, which the stack and window choices must agree on
+            unsigned int digits = 1 + random() % 9;
+            bank.resize(k + random() % (4 * size));
+            for (auto& digit : bank) digit = 9 - random() % digits;
+        }
+        return banks;
+    };
+    property.shrink = [k](const Banks& banks) {
+        return shrinkVector(banks, 1, [k](const std::vector<unsigned int>& bank) {
+            return shrinkVector(bank, k, [](unsigned int digit) {
+                std::vector<unsigned int> smaller;
+                for (auto d : shrinkNumber(digit, 1)) smaller.push_back(static_cast<unsigned int>(d));
+                return smaller;
+            });
+        });
+    };
+    property.text = bankText;
+    property.oracle = [k](const Banks& banks) {
+        unsigned long int result = 0;
+        for (auto& bank : banks) {
+            result = result + ((k == 2) ? day3::getLargestJoltageInBank(bank) : largestJoltageByWindow(bank, k));
+        }
+        return result;
+    };
+    if (k == 2) {
+        property.engines.emplace_back("getLargestJoltageInBank", [](const Banks& banks) {
+            unsigned long int result = 0;
+            day3::BankBuffer buffer = bankBuffer(banks);
+            for (std::size_t i = 0; i < buffer.size(); i++) result = result + day3::getLargestJoltageInBank(buffer.bank(i));
+            return result;
+        });
+    }
+    property.engines.emplace_back("getLargestJoltage", [k](const Banks& banks) {
+        unsigned long int result = 0;
+        day3::BankBuffer buffer = bankBuffer(banks);
+        for (std::size_t i = 0; i < buffer.size(); i++) result = result + day3::getLargestJoltage(buffer.bank(i), k);
+        return result;
+    });
+    property.engines.emplace_back("sumLargestJoltage", [k](const Banks& banks) {
+        return day3::sumLargestJoltage(bankBuffer(banks), k, 3);
+    });
+    property.engines.emplace_back("solvePuzzle", [k](const Banks& banks) {
+        return day3::solvePuzzle(inputFile(bankText(banks)), k);
+    });
+    property.engines.emplace_back("solveSnapshot", [k](const Banks& banks) {
+        return day3::solveSnapshot(snapshotOf(bankText(banks), day3::openSnapshot), k, 2);
+    });
+    return property;
+}
+
+void addDay3(std::vector<Check>& checks) {
+    addChecks(checks, bankProperty(2));
+    addChecks(checks, bankProperty(12));
+}
+
+// Day 4
+
+// Rows of 0 or 1, without the padding of day4::readPuzzleInput
+using Floor = std::vector<std::vector<unsigned int>>;
+
+std::string floorText(const Floor& floor) {
+    std::string text;
+    for (auto& row : floor) {
+        for (auto cell : row) text += cell ? '@' : '.';
+        text += '\n';
+    }
+    return text;
+}
+
+Floor padded(const Floor& floor) {
+    Floor grid(1, std::vector<unsigned int>(floor[0].size() + 2, 0));
+    for (auto& row : floor) {
+        grid.emplace_back(1, 0);
+        grid.back().insert(grid.back().end(), row.begin(), row.end());
+        grid.back().push_back(0);
+    }
+    grid.push_back(grid[0]);
+    return grid;
+}
+
+Floor generateFloor(Random& random, std::size_t size) {
+    // Up to a few words wide, so rows end inside and on the edge of 64-bit words
+    Floor floor(1 + random() % (2 * size), std::vector<unsigned int>(1 + random() % (12 * size)));
+    unsigned int density = random() % 101;
+    for (auto& row : floor) {
+        for (auto& cell : row) cell = (random() % 100) < density;
+    }
+    return floor;
+}
+
+std::vector<Floor> shrinkFloor(const Floor& floor) {
+    std::vector<Floor> result = shrinkVector(floor, 1);
+    std::size_t cols = floor[0].size();
+    for (std::size_t chunk = std::max<std::size_t>(1, cols / 2); chunk >= 1 && chunk < cols; chunk /= 2) {
+        for (std::size_t begin = 0; begin + chunk <= cols; begin += chunk) {
+            Floor smaller = floor;
+            for (auto& row : smaller) row.erase(row.begin() + begin, row.begin() + begin + chunk);
+            result.push_back(std::move(smaller));
+        }
+    }
+    // Clearing single cells only pays off once the grid is small
+    if (floor.size() * cols <= 256) {
+        for (std::size_t r = 0; r < floor.size(); r++) {
+            for (std::size_t c = 0; c < cols; c++) {
+                if (!floor[r][c]) continue;
+                Floor smaller = floor;
+                smaller[r][c] = 0;
+                result.push_back(std::move(smaller));
+            }
+        }
+    }
+    return result;
+}
+
+unsigned long int countByRows(const Floor& floor, day4::RowKernel kernel) {
+    auto grid = day4::toByteGrid(padded(floor));
+    unsigned long int result = 0;
+    for (std::size_t r = 1; r + 1 < grid.size(); r++) {
+        result = result + kernel(grid[r - 1].data(), grid[r].data(), grid[r + 1].data(), grid[r].size());
+    }
+    return result;
+}
+
+void addDay4(std::vector<Check>& checks) {
+    // Small bands and tiles, so that a grid spans several of both
+    const day4::SweepGeometry geometry{3, 5};
+
+    Property<Floor> accessible{"day4 accessible", generateFloor, shrinkFloor, floorText,
+        [](const Floor& floor) {
+            auto grid = padded(floor);
+            unsigned long int result = 0;
+            for (std::size_t r = 1; r + 1 < grid.size(); r++) {
+                result = result + day4::countAccessibleRolls(grid[r - 1], grid[r], grid[r + 1]);
+            }
+            return result;
+        }, {}};
+    accessible.engines = {
+        {"countAccessibleRollsPacked", [](const Floor& floor) {
+            return day4::countAccessibleRollsPacked(day4::packGrid(padded(floor)));
+        }},
+        {"countAccessibleRollsScalar", [](const Floor& floor) {
+            return countByRows(floor, day4::countAccessibleRollsScalar);
+        }},
+        {"countAccessibleRollsTiled packed", [geometry](const Floor& floor) {
+            return day4::countAccessibleRollsTiled(day4::packGrid(padded(floor)), geometry, 2);
+        }},
+        {"countAccessibleRollsTiled bytes", [geometry](const Floor& floor) {
+            return day4::countAccessibleRollsTiled(day4::toByteGrid(padded(floor)), geometry, 2);
+        }},
+        {"FloorMap", [](const Floor& floor) {
+            // Rolls placed one at a time on an empty floor
+            Floor empty(floor.size(), std::vector<unsigned int>(floor[0].size(), 0));
+            day4::FloorMap map(padded(empty));
+            for (std::size_t r = 0; r < floor.size(); r++) {
+                for (std::size_t c = 0; c < floor[r].size(); c++) {
+                    if (floor[r][c]) map.set(r, c);
+                }
+            }
+            return map.accessible();
+        }},
+        {"solvePuzzle", [](const Floor& floor) {
+            return static_cast<unsigned long int>(day4::solvePuzzle(inputFile(floorText(floor))));
+        }},
+        {"solvePuzzleTiled", [geometry](const Floor& floor) {
+            return day4::solvePuzzleTiled(inputFile(floorText(floor)), geometry, 2);
+        }},
+        {"solveSnapshot", [](const Floor& floor) {
+            return day4::solveSnapshot(snapshotOf(floorText(floor), day4::openSnapshot));
+        }},
+    };
+#if defined(__x86_64__) || defined(__i386__)
+    accessible.engines.emplace_back("countAccessibleRollsSSE2", [](const Floor& floor) {
+        return countByRows(floor, day4::countAccessibleRollsSSE2);
+    });
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        accessible.engines.emplace_back("countAccessibleRollsAVX2", [](const Floor& floor) {
+            return countByRows(floor, day4::countAccessibleRollsAVX2);
+        });
+    }
+#endif
+    addChecks(checks, std::move(accessible));
+
+    Property<Floor> removed{"day4 removed", generateFloor, shrinkFloor, floorText,
+        [](const Floor& floor) { return day4::removeAccessibleRollsByRescan(padded(floor)).removed; }, {}};
+    removed.engines = {
+        {"removeAccessibleRolls", [](const Floor& floor) { return day4::removeAccessibleRolls(padded(floor)).removed; }},
+        {"removeAccessibleRolls packed", [](const Floor& floor) {
+            return day4::removeAccessibleRolls(day4::packGrid(padded(floor))).removed;
+        }},
+        {"snapshotGrid", [](const Floor& floor) {
+            Snapshot snapshot = snapshotOf(floorText(floor), day4::openSnapshot);
+            return day4::removeAccessibleRolls(day4::snapshotGrid(snapshot)).removed;
+        }},
+    };
+    addChecks(checks, std::move(removed));
+}
+
+// Day 5
+
+struct Database {
+    std::vector<Range> ranges;
+    std::vector<unsigned long int> IDs;
+};
+
+std::string databaseText(const Database& c) {
+    std::string text;
+    for (auto range : c.ranges) text += std::to_string(range.first) + "-" + std::to_string(range.second) + "\n";
+    text += "\n";
+    for (auto id : c.IDs) text += std::to_string(id) + "\n";
+    return text;
+}
+
+Database generateDatabase(Random& random, std::size_t size) {
+    Database c;
+    unsigned long int scale = 1;
+    for (unsigned int d = 1 + random() % 15; d > 0; d--) scale = scale * 10;
+    c.ranges.resize(1 + random() % size);
+    for (auto& range : c.ranges) {
+        range.first = random() % scale;
+        unsigned long int width = (random() & 1) ? random() % (scale / c.ranges.size() + 1) : random() % 10;
+        range.second = range.first + width;
+    }
+    c.IDs.resize(1 + random() % (4 * size));
+    for (auto& id : c.IDs) {
+        if (random() & 1) {
+            id = random() % (scale + scale / 10);
+            continue;
+        }
+        // On or next to the bounds of a range
+        const Range& range = c.ranges[random() % c.ranges.size()];
+        switch (random() % 5) {
+            case 0: id = (range.first > 0) ? range.first - 1 : range.first; break;
+            case 1: id = range.first; break;
+            case 2: id = range.first + (range.second - range.first) / 2; break;
+            case 3: id = range.second; break;
+            default: id = range.second + 1; break;
+        }
+    }
+    return c;
+}
+
+std::vector<Database> shrinkDatabase(const Database& c) {
+    std::vector<Database> result;
+    // Everything moved down by the smallest value, which keeps how they overlap
+    unsigned long int lowest = c.ranges[0].first;
+    for (auto range : c.ranges) lowest = std::min(lowest, range.first);
+    for (auto id : c.IDs) lowest = std::min(lowest, id);
+    if (lowest > 0) {
+        Database shifted = c;
+        for (auto& range : shifted.ranges) range = {range.first - lowest, range.second - lowest};
+        for (auto& id : shifted.IDs) id = id - lowest;
+        result.push_back(std::move(shifted));
+    }
+    auto ranges = shrinkVector(c.ranges, 1, [](const Range& range) {
+        auto [first, last] = range;
+        std::vector<Range> smaller;
+        if (last > first) {
+            smaller.emplace_back(first, first);
+            smaller.emplace_back(first + (last - first) / 2 + 1, last);
+            smaller.emplace_back(first, first + (last - first) / 2);
+        }
+        for (auto f : shrinkNumber(first)) smaller.emplace_back(f, f + (last - first));
+        return smaller;
+    });
+    for (auto& r : ranges) result.push_back({std::move(r), c.IDs});
+    auto IDs = shrinkVector(c.IDs, 1, [](unsigned long int id) { return shrinkNumber(id); });
+    for (auto& i : IDs) result.push_back({c.ranges, std::move(i)});
+    return result;
+}
+
+void addDay5(std::vector<Check>& checks) {
+    Property<Database> fresh{"day5 fresh", generateDatabase, shrinkDatabase, databaseText,
+        [](const Database& c) { return static_cast<unsigned long int>(day5::countFreshProducts(c.ranges, c.IDs)); }, {}};
+    fresh.engines = {
+        {"countFreshProductsIndexed", [](const Database& c) {
+            return static_cast<unsigned long int>(day5::countFreshProductsIndexed(day5::mergeRanges(c.ranges), c.IDs));
+        }},
+        {"countFreshProductsSorted", [](const Database& c) {
+            return static_cast<unsigned long int>(day5::countFreshProductsSorted(day5::mergeRanges(c.ranges), c.IDs));
+        }},
+        {"FreshIndex", [](const Database& c) {
+            return static_cast<unsigned long int>(day5::FreshIndex(day5::mergeRanges(c.ranges)).count(c.IDs));
+        }},
+        {"FreshIndex scalar", [](const Database& c) {
+            day5::FreshIndex index(day5::mergeRanges(c.ranges));
+            std::vector<uint64_t> bits((c.IDs.size() + 63) / 64, 0);
+            index.queryScalar(c.IDs.data(), c.IDs.size(), bits.data());
+            unsigned long int result = 0;
+            for (auto word : bits) result = result + __builtin_popcountll(word);
+            return result;
+        }},
+        {"solvePuzzle", [](const Database& c) {
+            return static_cast<unsigned long int>(day5::solvePuzzle(inputFile(databaseText(c))));
+        }},
+        {"solveSnapshot", [](const Database& c) {
+            return day5::solveSnapshot(snapshotOf(databaseText(c), day5::openSnapshot));
+        }},
+    };
+    addChecks(checks, std::move(fresh));
+
+    Property<Database> freshIDs{"day5 fresh IDs", generateDatabase, shrinkDatabase, databaseText,
+        [](const Database& c) {
+            // Split the line at every range start and every ID after a range end, and
+            // count the pieces that some range covers
+            std::set<unsigned long int> cuts;
+            for (auto range : c.ranges) {
+                cuts.insert(range.first);
+                cuts.insert(range.second + 1);
+            }
+            unsigned long int result = 0;
+            for (auto cut = cuts.begin(); std::next(cut) != cuts.end(); cut++) {
+                for (auto range : c.ranges) {
+                    if (range.first <= *cut && *cut <= range.second) {
+                        result = result + (*std::next(cut) - *cut);
+                        break;
+                    }
+                }
+            }
+            return result;
+        }, {}};
+    freshIDs.engines = {
+        {"countFreshIDs", [](const Database& c) { return day5::countFreshIDs(c.ranges); }},
+        {"FreshCoverage", [](const Database& c) {
+            day5::FreshCoverage coverage;
+            for (auto range : c.ranges) coverage.add(range.first, range.second);
+            return coverage.total();
+        }},
+        {"solvePuzzlePartTwo", [](const Database& c) { return day5::solvePuzzlePartTwo(inputFile(databaseText(c))); }},
+        {"solveSnapshotPartTwo", [](const Database& c) {
+            return day5::solveSnapshotPartTwo(snapshotOf(databaseText(c), day5::openSnapshot));
+        }},
+    };
+    addChecks(checks, std::move(freshIDs));
+}
+
+} // namespace
+
+const std::vector<Check>& checks() {
+    static const std::vector<Check> all = [] {
+        std::vector<Check> result;
+        addDay1(result);
+        addDay2(result);
+        addDay3(result);
+        addDay4(result);
+        addDay5(result);
+        return result;
+    }();
+    return all;
+}
+
+} // namespace differential
@@ -0,0 +1,20 @@
+/* Differential checks of the 2025 solvers
+
+Every day registers the simple implementation of each part as the oracle, and its
+optimized paths as the engines checked against it.
+*/
+
+#ifndef AOC_2025_PROPERTIES_H
+#define AOC_2025_PROPERTIES_H
+
+#include <vector>
+
+#include "differential.h"
+
+namespace differential {
+
+const std::vector<Check>& checks();
+
+} // namespace differential
+
+#endif
@@ -0,0 +1,96 @@
+/* Tests for the differential checks, with an engine that has a planted bug */
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "differential.h"
+#include "../common/check.h"
+
+using namespace differential;
+
+int main() {
+
+    // Sum of a list of numbers, and an engine that drops every number of 50 or more
+    Property<std::vector<unsigned long int>> sum;
+    sum.name = "sum";
+    sum.generate = [](Random& random, std::size_t size) {
+        std::vector<unsigned long int> values(1 + random() % size);
+        for (auto& v : values) v = random() % 100;
+        return values;
+    };
+    sum.shrink = [](const std::vector<unsigned long int>& values) {
+        return shrinkVector(values, 1, [](unsigned long int v) { return shrinkNumber(v); });
+    };
+    sum.text = [](const std::vector<unsigned long int>& values) {
+        std::string text;
+        for (auto v : values) text += std::to_string(v) + "\n";
+        return text;
+    };
+    sum.oracle = [](const std::vector<unsigned long int>& values) {
+        unsigned long int result = 0;
+        for (auto v : values) result = result + v;
+        return result;
+    };
+    sum.engines = {
+        {"correct", sum.oracle},
+        {"small only", [](const std::vector<unsigned long int>& values) {
+            unsigned long int result = 0;
+            for (auto v : values) {
+                if (v < 50) result = result + v;
+            }
+            return result;
+        }},
+        {"throws", [](const std::vector<unsigned long int>& values) -> unsigned long int {
+            if (values.size() > 2) throw std::runtime_error("too many");
+            return values.size() == 2 ? values[0] + values[1] : values[0];
+        }},
+    };
+    std::vector<Check> checks;
+    addChecks(checks, sum);
+    CHECK(checks.size() == 3);
+    CHECK(checks[0].name == "sum/correct" && checks[1].name == "sum/small only");
+    std::cout << "All tests for addChecks pass" << std::endl;
+
+    // Check a correct engine passes and a wrong one fails on a minimal case
+    unsigned int failures = 0;
+    for (uint64_t i = 0; i < 200; i++) {
+        CHECK(!checks[0].run(caseSeed(1, i), 1 + i % 16));
+        auto failure = checks[1].run(caseSeed(1, i), 1 + i % 16);
+        if (!failure) continue;
+        failures++;
+        CHECK(failure->input == "50\n");
+        CHECK(failure->expected == 50 && failure->actual == "0");
+        CHECK(failure->check == "sum/small only" && failure->seed == caseSeed(1, i));
+    }
+    CHECK(failures > 100);
+    for (uint64_t i = 0; i < 50; i++) {
+        auto thrown = checks[2].run(caseSeed(2, i), 16);
+        if (!thrown) continue;
+        CHECK(thrown->actual == "exception: too many");
+        CHECK(thrown->input == "0\n0\n0\n");
+    }
+    std::cout << "All tests for shrinking pass" << std::endl;
+
+    // Check a seed and size always give the same case
+    Random a(caseSeed(7, 3));
+    Random b(caseSeed(7, 3));
+    CHECK(sum.generate(a, 10) == sum.generate(b, 10));
+    CHECK(caseSeed(7, 3) != caseSeed(7, 4) && caseSeed(7, 3) != caseSeed(8, 3));
+    std::cout << "All tests for case seeds pass" << std::endl;
+
+    // Check the shrink candidates
+    CHECK((shrinkNumber(10) == std::vector<unsigned long int>{0, 5, 9}));
+    CHECK((shrinkNumber(2, 1) == std::vector<unsigned long int>{1}));
+    CHECK(shrinkNumber(1, 1).empty());
+    std::vector<unsigned long int> values{1, 2, 3, 4};
+    auto smaller = shrinkVector(values, 1);
+    CHECK((smaller[0] == std::vector<unsigned long int>{3, 4} && smaller[1] == std::vector<unsigned long int>{1, 2}));
+    CHECK(smaller.size() == 2 + 4);
+    CHECK(shrinkVector(std::vector<unsigned long int>{1}, 1).empty());
+    CHECK(shrinkVector(std::vector<unsigned long int>{1}, 0).size() == 1);
+    std::cout << "All tests for shrink candidates pass" << std::endl;
+
+    return 0;
+}
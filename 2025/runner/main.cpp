@@ -0,0 +1,240 @@
+/* Runner solving several days of the 2025 puzzles in one process
+
+Usage: aoc_run [--days 1,2,...] [--parts 1,2] [--threads N] [--inputs DIR] [--test]
+              [--snapshot DIR [--verify]]
+
+Runs the selected parts of the selected days (default all) concurrently on a pool
+of N threads (default one per core). Each day first parses its input, once for all
+its parts, and its parts are queued with the parsed input once the load is done, so
+loading the input of one day overlaps with solving the others. Inputs are read from
+DIR/dayN/input_dayN.txt, or testinput_dayN.txt with --test, in which case every
+answer is also checked against the known answer for the test input.
+
+The parts that solve in parallel share the N threads: each gets N divided by the
+number of parts (at least one), so the parts running at once never use more than
+N threads together.
+
+With --snapshot, the load stage opens the snapshot of the parsed input kept in
+DIR/dayN.snap (DIR/testdayN.snap with --test) instead, writing it first when it is
+missing or the size or modification time of the input changed, and the parts are
+solved from the snapshot. The first run pays for parsing once; later runs map the
+snapshot and skip parsing. --verify also checks the content of the input and the
+payload of every snapshot against their checksums, reading both files in full.
+
+Prints the answers, the wall time of every stage and the peak resident set size of
+the whole process. Stages run concurrently, so the peak is not broken down by stage.
+The exit status is 1 when a stage failed or, with --test, an answer is wrong.
+*/
+
+#include <algorithm>
+#include <any>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+
+#include "puzzles.h"
+#include "../common/input.h"
+#include "../common/parallel.h"
+
+#ifndef AOC_INPUT_DIR
+#define AOC_INPUT_DIR "."
+#endif
+
+using namespace runner;
+
+struct Stage {
+    std::string name{};
+    double milliseconds = 0;
+    unsigned long int answer = 0;
+    unsigned long int bytes = 0;
+    std::string detail{};
+    std::string error{};
+};
+
+long peakResidentKiB() {
+    struct rusage usage;
+    ::getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+std::vector<unsigned int> parseList(const std::string& text) {
+    std::vector<unsigned int> values;
+    FieldSplitter fields(text, ',');
+    std::string_view field;
+    while (fields.next(field)) {
+        if (!field.empty()) values.push_back(parseNumber<unsigned int>(field));
+    }
+    return values;
+}
+
+bool selected(const std::vector<unsigned int>& list, unsigned int value) {
+    if (list.empty()) return true;
+    for (auto v : list) {
+        if (v == value) return true;
+    }
+    return false;
+}
+
+// Run f and record its wall time, or the error it throws, in stage
+template <typename F>
+bool timeStage(Stage& stage, F&& f) {
+    auto start = std::chrono::steady_clock::now();
+    bool ok = true;
+    try {
+        f();
+    }
+    catch (const std::exception& e) {
+        stage.error = e.what();
+        ok = false;
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    stage.milliseconds = elapsed.count();
+    return ok;
+}
+
+int main(int argc, char** argv) {
+
+    std::vector<unsigned int> days;
+    std::vector<unsigned int> parts;
+    unsigned int threads = defaultThreadCount();
+    std::string inputs = AOC_INPUT_DIR;
+    std::string prefix = "input_day";
+    bool test = false;
+    std::string snapshots;
+    bool verify = false;
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        if (option == "--test") {
+            prefix = "testinput_day";
+            test = true;
+            continue;
+        }
+        if (option == "--verify") {
+            verify = true;
+            continue;
+        }
+        if (i + 1 >= argc) throw std::runtime_error("Missing value for option: " + option);
+        std::string value = argv[++i];
+        if (option == "--days") days = parseList(value);
+        else if (option == "--parts") parts = parseList(value);
+        else if (option == "--threads") threads = parseNumber<unsigned int>(value);
+        else if (option == "--inputs") inputs = value;
+        else if (option == "--snapshot") snapshots = value;
+        else throw std::runtime_error("Unknown option: " + option);
+    }
+
+    if (!snapshots.empty()) std::filesystem::create_directories(snapshots);
+
+    // One load stage per day followed by its parts, laid out up front so that every
+    // task writes only its own stage
+    struct Job {
+        const Puzzle* puzzle;
+        std::string inputfile;
+        std::string snapshotfile;
+        std::size_t load;
+        std::vector<std::pair<const Part*, std::size_t>> parts;
+    };
+    std::vector<Stage> stages;
+    std::vector<Job> jobs;
+    for (const auto& puzzle : puzzles()) {
+        if (!selected(days, puzzle.day)) continue;
+        std::string day = "day" + std::to_string(puzzle.day);
+        Job job{&puzzle, inputs + "/" + day + "/" + prefix + std::to_string(puzzle.day) + ".txt", "", stages.size(), {}};
+        if (!snapshots.empty() && puzzle.openSnapshot) {
+            job.snapshotfile = snapshots + "/" + (prefix == "input_day" ? "" : "test") + day + ".snap";
+        }
+        stages.push_back({.name = "Day " + std::to_string(puzzle.day) + " load"});
+        for (std::size_t p = 0; p < puzzle.parts.size(); p++) {
+            if (!selected(parts, p + 1)) continue;
+            job.parts.emplace_back(&puzzle.parts[p], stages.size());
+            stages.push_back({.name = "Day " + std::to_string(puzzle.day) + " part " + std::to_string(p + 1) +
+                 " (" + puzzle.parts[p].name + ")"});
+        }
+        jobs.push_back(std::move(job));
+    }
+
+    // At most min(threads, parts) parts run at once, on partThreads threads each
+    const unsigned int partThreads = std::max<std::size_t>(1, threads / std::max<std::size_t>(1, stages.size() - jobs.size()));
+
+    auto start = std::chrono::steady_clock::now();
+    {
+        ThreadPool pool(threads);
+        for (const auto& job : jobs) {
+            pool.submit([&pool, &job, &stages, partThreads, verify] {
+                Stage& load = stages[job.load];
+                std::shared_ptr<const Snapshot> snapshot;
+                std::shared_ptr<const std::any> input;
+                bool loaded = timeStage(load, [&] {
+                    if (!job.snapshotfile.empty()) {
+                        snapshot = std::make_shared<const Snapshot>(job.puzzle->openSnapshot(job.inputfile, job.snapshotfile, verify));
+                        load.detail = "snapshot " + job.snapshotfile;
+                        return;
+                    }
+                    input = std::make_shared<const std::any>(job.puzzle->load(job.inputfile));
+                    load.bytes = std::filesystem::file_size(job.inputfile);
+                });
+                if (!loaded) {
+                    for (auto part : job.parts) stages[part.second].error = "skipped, the input did not load";
+                    return;
+                }
+                for (auto part : job.parts) {
+                    pool.submit([&stages, part, snapshot, input, partThreads] {
+                        Stage& stage = stages[part.second];
+                        timeStage(stage, [&] {
+                            if (snapshot) stage.answer = part.first->solveSnapshot(*snapshot, partThreads);
+                            else stage.answer = part.first->solve(*input, partThreads);
+                        });
+                    });
+                }
+            });
+        }
+        pool.wait();
+    }
+    std::chrono::duration<double, std::milli> wall = std::chrono::steady_clock::now() - start;
+
+    if (test) {
+        for (const auto& job : jobs) {
+            for (auto part : job.parts) {
+                Stage& stage = stages[part.second];
+                if (stage.error.empty() && stage.answer != part.first->testAnswer) {
+                    stage.error = "wrong answer " + std::to_string(stage.answer) + ", expected " +
+                         std::to_string(part.first->testAnswer);
+                }
+            }
+        }
+    }
+
+    int status = 0;
+    double total = 0;
+    for (const auto& stage : stages) {
+        char time[32];
+        std::snprintf(time, sizeof(time), "%10.3f ms", stage.milliseconds);
+        std::cout << time << "  " << stage.name << ": ";
+        if (!stage.error.empty()) {
+            std::cout << "error: " << stage.error;
+            status = 1;
+        }
+        else if (!stage.detail.empty()) {
+            std::cout << stage.detail;
+        }
+        else if (stage.bytes > 0) {
+            std::cout << "parsed " << stage.bytes << " bytes";
+        }
+        else {
+            std::cout << stage.answer;
+        }
+        std::cout << std::endl;
+        total = total + stage.milliseconds;
+    }
+    std::cout << "Wall time " << wall.count() << " ms for " << total << " ms of stages on "
+         << threads << " threads, process peak RSS " << peakResidentKiB() << " KiB" << std::endl;
+
+    return status;
+}
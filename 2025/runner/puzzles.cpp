@@ -0,0 +1,65 @@
+/* Registry of the 2025 puzzles for the runner */
+
+#include "puzzles.h"
+
+#include "day1.h"
+#include "day2.h"
+#include "day3.h"
+#include "day4.h"
+#include "day5.h"
+
+namespace runner {
+
+namespace {
+
+// Parsed inputs of the days, as returned by their loaders
+using Rotations = std::pair<std::vector<day1::Direction>, std::vector<unsigned int>>;
+using Ranges = std::vector<std::pair<unsigned long int, unsigned long int>>;
+using Database = std::pair<Ranges, std::vector<unsigned long int>>;
+
+template <typename T>
+const T& input(const std::any& parsed) {
+    return std::any_cast<const T&>(parsed);
+}
+
+}
+
+const std::vector<Puzzle>& puzzles() {
+    static const std::vector<Puzzle> all = {
+        {1, "Secret Entrance", [](const std::string& f) { return std::any(day1::readPuzzleInput(f)); }, {
+            {"landings", 3, [](const std::any& in, unsigned int) { return day1::countZeros(50, input<Rotations>(in)); },
+                 [](const Snapshot& s, unsigned int) { return day1::solveSnapshot(s, 50); }},
+            {"crossings", 6, [](const std::any& in, unsigned int) { return day1::countZeros(50, input<Rotations>(in), day1::CROSSINGS); },
+                 [](const Snapshot& s, unsigned int) { return day1::solveSnapshot(s, 50, day1::CROSSINGS); }},
+        }, day1::openSnapshot},
+        {2, "Gift Shop", [](const std::string& f) { return std::any(day2::readPuzzleInput(f)); }, {
+            {"twice", 1227775554, [](const std::any& in, unsigned int threads) { return day2::sumRangesParallel(input<Ranges>(in), day2::sumInvalidIDs, threads); },
+                 [](const Snapshot& s, unsigned int) { return day2::solveSnapshot(s); }},
+            {"repeated", 4174379265, [](const std::any& in, unsigned int threads) { return day2::sumRangesParallel(input<Ranges>(in), day2::sumRepeatedPatternIDs, threads); },
+                 [](const Snapshot& s, unsigned int) { return day2::solveSnapshot(s, day2::REPEATED); }},
+        }, day2::openSnapshot},
+        {3, "Lobby", [](const std::string& f) { return std::any(day3::readBankBuffer(f)); }, {
+            {"2 batteries", 357, [](const std::any& in, unsigned int threads) { return day3::sumLargestJoltage(input<day3::BankBuffer>(in), 2, threads); },
+                 [](const Snapshot& s, unsigned int threads) { return day3::solveSnapshot(s, 2, threads); }},
+            {"12 batteries", 3121910778619, [](const std::any& in, unsigned int threads) { return day3::sumLargestJoltage(input<day3::BankBuffer>(in), 12, threads); },
+                 [](const Snapshot& s, unsigned int threads) { return day3::solveSnapshot(s, 12, threads); }},
+        }, day3::openSnapshot},
+        {4, "Printing Department", [](const std::string& f) { return std::any(day4::readPackedPuzzleInput(f)); }, {
+            {"accessible", 13, [](const std::any& in, unsigned int threads) { return day4::countAccessibleRollsTiled(input<day4::PackedGrid>(in), day4::SweepGeometry(), threads); },
+                 [](const Snapshot& s, unsigned int threads) { return day4::solveSnapshot(s, threads); }},
+            {"removed", 43, [](const std::any& in, unsigned int) { return day4::removeAccessibleRolls(input<day4::PackedGrid>(in)).removed; },
+                 [](const Snapshot& s, unsigned int) { return day4::removeAccessibleRolls(day4::snapshotGrid(s)).removed; }},
+        }, day4::openSnapshot},
+        {5, "Cafeteria", [](const std::string& f) { return std::any(day5::readPuzzleInput(f)); }, {
+            {"fresh", 3, [](const std::any& in, unsigned int) {
+                const auto& database = input<Database>(in);
+                return static_cast<unsigned long int>(day5::countFreshProductsSorted(day5::mergeRanges(database.first), database.second));
+            }, [](const Snapshot& s, unsigned int) { return day5::solveSnapshot(s); }},
+            {"fresh IDs", 14, [](const std::any& in, unsigned int) { return day5::countFreshIDs(input<Database>(in).first); },
+                 [](const Snapshot& s, unsigned int) { return day5::solveSnapshotPartTwo(s); }},
+        }, day5::openSnapshot},
+    };
+    return all;
+}
+
+} // namespace runner
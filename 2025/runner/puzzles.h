@@ -0,0 +1,49 @@
+/* Registry of the 2025 puzzles for the runner
+
+Every day registers its parts behind the same interface: a loader that parses the
+input file once, and for each part a solver that takes the parsed input and returns
+the answer. The parsed input is type-erased in a std::any, whose type only the
+loader and the solvers of that day know. Days that can snapshot their parsed input
+(see common/snapshot.h) also register how to open the snapshot and a solver for
+each part that works on it.
+
+Solvers are called from the runner's thread pool, so they get the number of threads
+they may use (the calling thread included) and must not start more than that.
+*/
+
+#ifndef AOC_2025_PUZZLES_H
+#define AOC_2025_PUZZLES_H
+
+#include <any>
+#include <string>
+#include <vector>
+
+#include "../common/snapshot.h"
+
+namespace runner {
+
+using Loader = std::any (*)(const std::string& inputfile);
+using Solver = unsigned long int (*)(const std::any& input, unsigned int threads);
+using SnapshotSolver = unsigned long int (*)(const Snapshot& snapshot, unsigned int threads);
+using SnapshotOpener = Snapshot (*)(const std::string& inputfile, const std::string& snapshotfile, bool verify);
+
+struct Part {
+    const char* name;
+    unsigned long int testAnswer; // Answer for the day's testinput file
+    Solver solve;
+    SnapshotSolver solveSnapshot = nullptr;
+};
+
+struct Puzzle {
+    unsigned int day;
+    const char* title;
+    Loader load;
+    std::vector<Part> parts;
+    SnapshotOpener openSnapshot = nullptr;
+};
+
+const std::vector<Puzzle>& puzzles();
+
+} // namespace runner
+
+#endif